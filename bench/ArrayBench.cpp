@@ -0,0 +1,185 @@
+#include "AllocationCounter.h" // For getAllocationCount
+#include "Arena.h"             // For Arena class
+#include "Array.h"             // For Array class
+#include <chrono>              // For timing
+#include <cstdint>             // For uint64_t
+#include <iostream>            // For std::cout
+#include <string>              // For std::string
+#include <vector>              // For std::vector
+
+// Compares Array against std::vector on the operations the game leans on
+//
+// Usage: array_bench [elements]
+
+// How many times each test is repeated, the fastest run is reported
+const int RUNS = 5;
+
+// Stops the compiler from optimizing away results
+volatile uint64_t sink = 0;
+
+/**
+ * Times a test, keeping the fastest run
+ *
+ * @param test: The test to run
+ *
+ * @returns The fastest run, in milliseconds
+ */
+template <typename Test>
+double best(Test test)
+{
+  double fastest = 0.0;
+  for (int run = 0; run < RUNS; ++run)
+  {
+    auto start = std::chrono::steady_clock::now();
+    test();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    if (run == 0 or elapsed.count() < fastest)
+      fastest = elapsed.count();
+  }
+  return fastest;
+}
+
+/**
+ * Prints one row of results
+ *
+ * @param name:   What was tested
+ * @param array:  Time taken by Array, in milliseconds
+ * @param vector: Time taken by std::vector, in milliseconds
+ */
+void report(const char* name, double array, double vector)
+{
+  std::cout << name << ": Array " << array << " ms, std::vector " << vector << " ms (" << array / vector << "x)\n";
+}
+
+int main(int argc, char** argv)
+{
+  int elements = argc > 1 ? std::stoi(argv[1]) : 1000000;
+  std::cout << elements << " elements, best of " << RUNS << "\n";
+
+  // Appending, letting the container grow
+  report("pushBack", best([&] {
+           Array<int> array;
+           for (int i = 0; i < elements; ++i)
+             array.pushBack(i);
+           sink += array.getSize();
+         }),
+         best([&] {
+           std::vector<int> vector;
+           for (int i = 0; i < elements; ++i)
+             vector.push_back(i);
+           sink += vector.size();
+         }));
+
+  // Appending after reserving
+  report("reserve + pushBack", best([&] {
+           Array<int> array;
+           array.reserve(elements);
+           for (int i = 0; i < elements; ++i)
+             array.pushBack(i);
+           sink += array.getSize();
+         }),
+         best([&] {
+           std::vector<int> vector;
+           vector.reserve(elements);
+           for (int i = 0; i < elements; ++i)
+             vector.push_back(i);
+           sink += vector.size();
+         }));
+
+  // Reading every element
+  Array<int> array;
+  std::vector<int> vector;
+  for (int i = 0; i < elements; ++i)
+  {
+    array.pushBack(i);
+    vector.push_back(i);
+  }
+
+  report("checked []", best([&] {
+           uint64_t sum = 0;
+           for (int i = 0; i < array.getSize(); ++i)
+             sum += array[i];
+           sink += sum;
+         }),
+         best([&] {
+           uint64_t sum = 0;
+           for (size_t i = 0; i < vector.size(); ++i)
+             sum += vector[i];
+           sink += sum;
+         }));
+
+  report("unchecked", best([&] {
+           uint64_t sum = 0;
+           for (int i = 0; i < array.getSize(); ++i)
+             sum += array.unchecked(i);
+           sink += sum;
+         }),
+         best([&] {
+           uint64_t sum = 0;
+           for (size_t i = 0; i < vector.size(); ++i)
+             sum += vector[i];
+           sink += sum;
+         }));
+
+  // Adding and removing right at a shrink boundary, which used to reallocate every time
+  report("push/pop at boundary", best([&] {
+           Array<int> churn;
+           for (int i = 0; i < 1024; ++i)
+             churn.pushBack(i);
+           for (int i = 0; i < elements; ++i)
+           {
+             churn.pushBack(i);
+             churn.popBack();
+           }
+           sink += churn.getSize();
+         }),
+         best([&] {
+           std::vector<int> churn;
+           for (int i = 0; i < 1024; ++i)
+             churn.push_back(i);
+           for (int i = 0; i < elements; ++i)
+           {
+             churn.push_back(i);
+             churn.pop_back();
+           }
+           sink += churn.size();
+         }));
+
+  // Growing an array of strings, which moves them instead of copying
+  int strings = elements / 10;
+  report("emplaceBack strings", best([&] {
+           Array<std::string> names;
+           for (int i = 0; i < strings; ++i)
+             names.emplaceBack(32, 'a' + i % 26);
+           sink += names.getSize();
+         }),
+         best([&] {
+           std::vector<std::string> names;
+           for (int i = 0; i < strings; ++i)
+             names.emplace_back(32, 'a' + i % 26);
+           sink += names.size();
+         }));
+
+  // Appending into an arena, which is freed all at once instead of element by element
+  Arena arena(sizeof(int) * elements * 4);
+  uint64_t allocations = 0;
+  report("arena pushBack", best([&] {
+           arena.reset();
+           uint64_t before = getAllocationCount();
+           Array<int, ArenaAllocator> array((ArenaAllocator(arena)));
+           for (int i = 0; i < elements; ++i)
+             array.pushBack(i);
+           allocations = getAllocationCount() - before;
+           sink += array.getSize();
+         }),
+         best([&] {
+           std::vector<int> vector;
+           for (int i = 0; i < elements; ++i)
+             vector.push_back(i);
+           sink += vector.size();
+         }));
+  if (ALLOCATIONS_COUNTED)
+    std::cout << "arena pushBack made " << allocations << " heap allocations after warming up\n";
+
+  return 0;
+}
@@ -0,0 +1,126 @@
+#include "Overlap.h" // For overlapBoxes
+#include <chrono>    // For timing
+#include <cstdint>   // For uint32_t and uint64_t
+#include <cstring>   // For std::memcmp
+#include <iostream>  // For std::cout
+#include <random>    // For std::mt19937
+#include <string>    // For std::stoi
+#include <vector>    // For std::vector
+
+// Measures the overlap kernels on runs of level-like hitboxes
+// Every kernel is checked against the scalar one before it is timed
+//
+// Usage: overlap_bench [tests per run size]
+
+// The run sizes measured
+const int RUN_SIZES[] = {100, 10000, 1000000};
+
+// How many times each test is repeated, the fastest run is reported
+const int RUNS = 5;
+
+// Stops the compiler from optimizing away results
+volatile uint64_t sink = 0;
+
+// A run of hitboxes and the arrays behind it
+struct Hitboxes
+{
+  std::vector<float> x, y, halfWidth, halfHeight;
+  std::vector<uint8_t> flags;
+  ObjectRange range;
+};
+
+/**
+ * Builds a run of hitboxes laid out like a level, a few objects per 50 pixel column
+ *
+ * @param size:    How many hitboxes
+ * @param rng:     Where the layout comes from
+ * @param objects: Filled with the hitboxes
+ */
+void build(int size, std::mt19937& rng, Hitboxes& objects)
+{
+  for (int i = 0; i < size; ++i)
+  {
+    int kind = rng() % 3;
+    objects.x.push_back(i / 4 * 50.0f + 25.0f);
+    objects.y.push_back(rng() % 15 * 50.0f + 25.0f);
+    objects.halfWidth.push_back(kind == 1 ? 10.0f : 25.0f);
+    objects.halfHeight.push_back(kind == 1 ? 15.0f : kind == 2 ? 12.5f : 25.0f);
+    objects.flags.push_back(kind == 1 ? COLLIDE_DEADLY : kind == 2 ? COLLIDE_SOLID | COLLIDE_PLATFORM : COLLIDE_SOLID);
+  }
+
+  objects.range.x = objects.x.data();
+  objects.range.y = objects.y.data();
+  objects.range.halfWidth = objects.halfWidth.data();
+  objects.range.halfHeight = objects.halfHeight.data();
+  objects.range.flags = objects.flags.data();
+  objects.range.size = size;
+}
+
+int main(int argc, char** argv)
+{
+  int tests = argc > 1 ? std::stoi(argv[1]) : 100000000;
+  OverlapKernel best = getOverlapKernel();
+  std::cout << "Fastest kernel on this CPU: " << getOverlapKernelName(best) << ", best of " << RUNS << "\n";
+
+  std::mt19937 rng(1);
+  for (int size : RUN_SIZES)
+  {
+    Hitboxes objects;
+    build(size, rng, objects);
+
+    // Player sized boxes spread over the run, each one is tested against every hitbox
+    int boxCount = tests / size > 1 ? tests / size : 1;
+    std::vector<Box> boxes;
+    for (int i = 0; i < boxCount; ++i)
+    {
+      Box box;
+      box.x = rng() % (size / 4 * 50 + 1) * 1.0f;
+      box.y = rng() % 750 * 1.0f;
+      box.halfWidth = 26.0f;
+      box.halfHeight = 26.0f;
+      boxes.push_back(box);
+    }
+
+    std::vector<uint32_t> mask(getOverlapMaskWords(size));
+    std::vector<uint32_t> expected(getOverlapMaskWords(size));
+    std::cout << size << " candidates, " << boxCount << " boxes\n";
+
+    for (int kernel = OVERLAP_SCALAR; kernel <= best; ++kernel)
+    {
+      // Check the kernel finds the same as the scalar one
+      for (int i = 0; i < boxCount and i < 100; ++i)
+      {
+        OverlapResult a = overlapBoxes(boxes[i], objects.range, expected.data(), OVERLAP_SCALAR);
+        OverlapResult b = overlapBoxes(boxes[i], objects.range, mask.data(), static_cast<OverlapKernel>(kernel));
+        if (a.hits != b.hits or a.firstDeadly != b.firstDeadly or a.bestLanding != b.bestLanding or
+            std::memcmp(mask.data(), expected.data(), mask.size() * sizeof(uint32_t)) != 0)
+        {
+          std::cout << getOverlapKernelName(static_cast<OverlapKernel>(kernel)) << " disagrees with scalar\n";
+          return 1;
+        }
+      }
+
+      double fastest = 0.0;
+      for (int run = 0; run < RUNS; ++run)
+      {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t hits = 0;
+        for (const Box& box : boxes)
+        {
+          OverlapResult result = overlapBoxes(box, objects.range, mask.data(), static_cast<OverlapKernel>(kernel));
+          hits += result.hits + result.firstDeadly + result.bestLanding;
+        }
+        sink += hits;
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (run == 0 or elapsed.count() < fastest)
+          fastest = elapsed.count();
+      }
+
+      double candidates = static_cast<double>(size) * boxCount;
+      std::cout << "  " << getOverlapKernelName(static_cast<OverlapKernel>(kernel)) << ": " << fastest << " ms, "
+                << candidates / fastest / 1000.0 << " M candidates/s\n";
+    }
+  }
+
+  return 0;
+}
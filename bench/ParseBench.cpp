@@ -0,0 +1,68 @@
+#include "LevelParser.h" // For LevelParser class
+#include <chrono>        // For timing
+#include <iostream>      // For std::cout
+#include <string>        // For std::string
+
+// Measures text level parser throughput on a synthetic level
+//
+// Usage: parse_bench [columns]
+
+// Columns the synthetic level is built from, in the style of stereo_madness
+const char* const SAMPLE_COLUMNS[] = {
+  "11 block",
+  "11 block|10 spike",
+  "11 block|10 block",
+  "11 block|10 block|9 block",
+  "",
+  "11 block|10 block|9 block|8 block|7 block|6 block|5 block",
+  "11 block|10 block|9 block|8 block|7 block|6 block|5 block|4 spike|3 platform",
+  "8 platform",
+};
+
+// How many times the parse is repeated, the fastest run is reported
+const int RUNS = 5;
+
+int main(int argc, char** argv)
+{
+  int columns = argc > 1 ? std::stoi(argv[1]) : 1000000;
+
+  // Build the level text
+  std::string text;
+  int sampleCount = sizeof(SAMPLE_COLUMNS) / sizeof(SAMPLE_COLUMNS[0]);
+  for (int i = 0; i < columns; ++i)
+  {
+    text += SAMPLE_COLUMNS[(i * 7 + i / 3) % sampleCount];
+    text += '\n';
+  }
+
+  const char* begin = text.data();
+  const char* end = begin + text.size();
+
+  double best = 0.0;
+  int spawnCount = 0;
+  for (int run = 0; run < RUNS; ++run)
+  {
+    auto start = std::chrono::steady_clock::now();
+
+    // Parse exactly the way LevelData and lvlc do
+    Array<uint32_t> offsets;
+    Array<Spawn> spawns;
+    ParseError error;
+    if (not LevelParser::parse(begin, end, offsets, spawns, error))
+    {
+      std::cout << "Parse error on line " << error.line << "\n";
+      return 1;
+    }
+
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+    if (run == 0 or seconds.count() < best)
+      best = seconds.count();
+    spawnCount = spawns.getSize();
+  }
+
+  std::cout << "Parsed " << columns << " columns (" << spawnCount << " objects, " << text.size() / (1024.0 * 1024.0)
+            << " MiB)\n";
+  std::cout << "Best of " << RUNS << ": " << best * 1000.0 << " ms, " << columns / best << " columns/sec, "
+            << text.size() / best / (1024.0 * 1024.0) << " MiB/sec\n";
+  return 0;
+}
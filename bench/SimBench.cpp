@@ -0,0 +1,100 @@
+#include "Arena.h"       // For Arena class
+#include "Constants.h"   // For SIMULATION_STEP and LEVEL_ARENA_SIZE
+#include "LevelData.h"   // For LevelData class
+#include "ObjectPools.h" // For ObjectPools class
+#include "Simulation.h"  // For Simulation class
+#include <chrono>        // For timing
+#include <cstdint>       // For uint64_t
+#include <iostream>      // For std::cout
+#include <string>        // For std::string
+
+// Measures how fast the game logic runs without a window
+//
+// Attempts are started from every few columns of the level, so the whole layout is
+// played even though the scripted jumps die early, and every step is counted
+//
+// Usage: sim_bench [level] [step length in seconds]
+
+// Columns between the starts of two attempts
+const int ATTEMPT_SPACING = 8;
+
+// Most steps an attempt runs for
+const int MAX_ATTEMPT_STEPS = SIMULATION_RATE * 30;
+
+// How many times the level is played in each run
+const int PLAYS_PER_RUN = 100;
+
+// How many runs there are, the fastest run is reported
+const int RUNS = 5;
+
+/**
+ * Plays attempts from every ATTEMPT_SPACING columns of a level
+ *
+ * @param data:       The level
+ * @param pools:      Where the objects come from
+ * @param arena:      Where the containers come from
+ * @param stepLength: The length of each step, in seconds
+ * @param deaths:     Set to how many attempts died
+ *
+ * @returns How many steps were run
+ */
+uint64_t play(const LevelData& data, ObjectPools& pools, Arena& arena, double stepLength, int& deaths)
+{
+  uint64_t steps = 0;
+  deaths = 0;
+  for (int start = 0; start < data.getColumnCount(); start += ATTEMPT_SPACING)
+  {
+    arena.reset();
+    Simulation simulation(data, pools, arena, start, stepLength);
+
+    // Hold jump for a quarter of every second
+    StepResult result = STEP_RUNNING;
+    while (result == STEP_RUNNING and simulation.getStep() < MAX_ATTEMPT_STEPS)
+    {
+      simulation.setJumping(simulation.getTime(1.0) - static_cast<int>(simulation.getTime(1.0)) < 0.25);
+      result = simulation.step();
+    }
+
+    steps += simulation.getStep();
+    if (result == STEP_DIED)
+      deaths++;
+  }
+  return steps;
+}
+
+int main(int argc, char** argv)
+{
+  std::string name = argc > 1 ? argv[1] : "bin/debug/data/stereo_madness";
+  double stepLength = argc > 2 ? std::stod(argv[2]) : SIMULATION_STEP;
+
+  LevelData data;
+  if (not data.load(name))
+  {
+    std::cout << "Couldn't load " << name << "\n";
+    return 1;
+  }
+
+  ObjectPools pools;
+  Arena arena(LEVEL_ARENA_SIZE);
+
+  double fastest = 0.0;
+  uint64_t steps = 0;
+  int deaths = 0;
+  for (int run = 0; run < RUNS; ++run)
+  {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < PLAYS_PER_RUN; ++i)
+      steps = play(data, pools, arena, stepLength, deaths);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (run == 0 or elapsed.count() < fastest)
+      fastest = elapsed.count();
+  }
+
+  double framesPerSecond = steps * PLAYS_PER_RUN / fastest;
+  std::cout << name << ": " << data.getColumnCount() << " columns, " << steps << " steps of " << stepLength * 1000.0
+            << " ms in " << deaths << " deaths, played " << PLAYS_PER_RUN << " times, best of " << RUNS << "\n";
+  std::cout << fastest * 1000.0 << " ms, " << framesPerSecond << " simulated frames/s ("
+            << framesPerSecond * stepLength << "x real time)\n";
+
+  return 0;
+}
@@ -0,0 +1,113 @@
+#include "AllocationCounter.h"
+#include <atomic>  // For std::atomic
+#include <cstdlib> // For malloc and free
+#include <new>     // For std::bad_alloc and std::nothrow_t
+
+#ifdef COUNT_ALLOCATIONS
+
+static std::atomic<uint64_t> allocationCount(0); // Allocations made so far
+static std::atomic<uint64_t> allocatedBytes(0);  // Bytes allocated so far
+
+/**
+ * Allocates memory and counts it
+ *
+ * @param size: The number of bytes
+ *
+ * @returns The memory, or nullptr if there is none
+ */
+static void* countedAllocate(size_t size)
+{
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  return malloc(size ? size : 1);
+}
+
+void* operator new(size_t size)
+{
+  void* memory = countedAllocate(size);
+  if (not memory)
+    throw std::bad_alloc();
+  return memory;
+}
+
+void* operator new[](size_t size)
+{
+  void* memory = countedAllocate(size);
+  if (not memory)
+    throw std::bad_alloc();
+  return memory;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+  return countedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+  return countedAllocate(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+  free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+  free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+  free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+  free(memory);
+}
+
+/**
+ * Gets the number of allocations made so far
+ *
+ * @returns The count, 0 if allocations aren't counted
+ */
+uint64_t getAllocationCount()
+{
+  return allocationCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * Gets the number of bytes allocated so far, including freed ones
+ *
+ * @returns The size, 0 if allocations aren't counted
+ */
+uint64_t getAllocatedBytes()
+{
+  return allocatedBytes.load(std::memory_order_relaxed);
+}
+
+#else
+
+/**
+ * Gets the number of allocations made so far
+ *
+ * @returns The count, 0 if allocations aren't counted
+ */
+uint64_t getAllocationCount()
+{
+  return 0;
+}
+
+/**
+ * Gets the number of bytes allocated so far, including freed ones
+ *
+ * @returns The size, 0 if allocations aren't counted
+ */
+uint64_t getAllocatedBytes()
+{
+  return 0;
+}
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstdint> // For uint64_t
+
+// Counts every allocation made through the global operator new
+//
+// Only built in with the COUNT_ALLOCATIONS define, which replaces the global
+// operator new and delete, otherwise the counts are always 0
+// Used to check that an attempt doesn't touch the heap once everything is warmed up
+
+#ifdef COUNT_ALLOCATIONS
+const bool ALLOCATIONS_COUNTED = true;
+#else
+const bool ALLOCATIONS_COUNTED = false;
+#endif
+
+/**
+ * Gets the number of allocations made so far
+ *
+ * @returns The count, 0 if allocations aren't counted
+ */
+uint64_t getAllocationCount();
+
+/**
+ * Gets the number of bytes allocated so far, including freed ones
+ *
+ * @returns The size, 0 if allocations aren't counted
+ */
+uint64_t getAllocatedBytes();
+
+#endif //! ALLOCATION_COUNTER_H
@@ -0,0 +1,101 @@
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include "Arena.h" // For Arena class
+#include <new>     // For placement new
+
+// Allocators for the containers, passed as a template parameter
+//
+// allocate() returns default constructed elements and deallocate() destroys them,
+// so containers can assign into their storage the same way whichever allocator they use
+
+// Takes memory from the heap with new[] and delete[], the default
+struct HeapAllocator
+{
+  /**
+   * Allocates default constructed elements
+   *
+   * @param count: The number of elements
+   *
+   * @returns The first element
+   */
+  template <typename T>
+  T* allocate(int count)
+  {
+    return new T[count];
+  }
+
+  /**
+   * Destroys elements and frees their memory
+   *
+   * @param items: The first element, may be nullptr
+   * @param count: The number of elements
+   */
+  template <typename T>
+  void deallocate(T* items, int)
+  {
+    delete[] items;
+  }
+};
+
+// Takes memory from an Arena, memory is only freed when the arena is reset
+// Without an arena it falls back to the heap
+class ArenaAllocator
+{
+  Arena* _arena = nullptr; // Where the memory comes from
+
+public:
+  // Default Constructor
+  ArenaAllocator() = default;
+
+  /**
+   * Parameterized Constructor
+   *
+   * @param arena: Where the memory comes from, must outlive every container using it
+   */
+  ArenaAllocator(Arena& arena) :
+    _arena(&arena)
+  {
+  }
+
+  /**
+   * Allocates default constructed elements
+   *
+   * @param count: The number of elements
+   *
+   * @returns The first element
+   */
+  template <typename T>
+  T* allocate(int count)
+  {
+    if (not _arena)
+      return new T[count];
+
+    T* items = static_cast<T*>(_arena->allocate(sizeof(T) * count, alignof(T)));
+    for (int i = 0; i < count; ++i)
+      new (items + i) T();
+    return items;
+  }
+
+  /**
+   * Destroys elements, the memory stays in the arena until it is reset
+   *
+   * @param items: The first element, may be nullptr
+   * @param count: The number of elements
+   */
+  template <typename T>
+  void deallocate(T* items, int count)
+  {
+    if (not _arena)
+    {
+      delete[] items;
+      return;
+    }
+
+    if (items)
+      for (int i = 0; i < count; ++i)
+        items[i].~T();
+  }
+};
+
+#endif //! ALLOCATOR_H
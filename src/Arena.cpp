@@ -0,0 +1,111 @@
+#include "Arena.h"
+#include <algorithm> // For std::max
+#include <cstdint>   // For uintptr_t
+
+/**
+ * Rounds a pointer up to an alignment
+ *
+ * @param pointer:   The pointer
+ * @param alignment: A power of two
+ *
+ * @returns How many bytes to skip
+ */
+static size_t padding(const char* pointer, size_t alignment)
+{
+  return (alignment - reinterpret_cast<uintptr_t>(pointer) % alignment) % alignment;
+}
+
+/**
+ * Parameterized Constructor
+ *
+ * @param capacity: Size of the main block, in bytes
+ */
+Arena::Arena(size_t capacity) :
+  _capacity(capacity)
+{
+  _block = new char[_capacity];
+}
+
+// Destructor, frees every block
+Arena::~Arena()
+{
+  while (_overflow)
+  {
+    Overflow* next = _overflow->next;
+    delete[] reinterpret_cast<char*>(_overflow);
+    _overflow = next;
+  }
+  delete[] _block;
+}
+
+/**
+ * Hands out memory, which stays valid until the next reset()
+ *
+ * @param size:      The number of bytes
+ * @param alignment: The alignment of the memory, a power of two
+ *
+ * @returns The memory
+ */
+void* Arena::allocate(size_t size, size_t alignment)
+{
+  // Bump along the main block while it has room
+  size_t skip = padding(_block + _used, alignment);
+  if (_used + skip + size <= _capacity)
+  {
+    void* memory = _block + _used + skip;
+    _used += skip + size;
+    return memory;
+  }
+
+  // Then along the newest overflow block
+  if (_overflow)
+  {
+    char* start = reinterpret_cast<char*>(_overflow + 1);
+    skip = padding(start + _overflowUsed, alignment);
+    if (_overflowUsed + skip + size <= _overflow->size)
+    {
+      void* memory = start + _overflowUsed + skip;
+      _overflowUsed += skip + size;
+      return memory;
+    }
+  }
+
+  // Take another block from the heap, at least as big as everything so far
+  size_t blockSize = std::max(size + alignment, _capacity + _overflowTotal);
+  Overflow* block = reinterpret_cast<Overflow*>(new char[sizeof(Overflow) + blockSize]);
+  block->next = _overflow;
+  block->size = blockSize;
+  _overflow = block;
+  _overflowTotal += blockSize;
+
+  char* start = reinterpret_cast<char*>(block + 1);
+  skip = padding(start, alignment);
+  _overflowUsed = skip + size;
+  return start + skip;
+}
+
+/**
+ * Frees everything at once, in O(1) unless the arena overflowed
+ * Anything still using the memory must not touch it again
+ */
+void Arena::reset()
+{
+  _used = 0;
+  if (not _overflow)
+    return;
+
+  // Free the overflow blocks
+  while (_overflow)
+  {
+    Overflow* next = _overflow->next;
+    delete[] reinterpret_cast<char*>(_overflow);
+    _overflow = next;
+  }
+
+  // Grow the main block so the same amount fits next time
+  _capacity += _overflowTotal;
+  _overflowTotal = 0;
+  _overflowUsed = 0;
+  delete[] _block;
+  _block = new char[_capacity];
+}
@@ -0,0 +1,82 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef> // For size_t
+
+// A bump allocator, memory is handed out in order and only ever freed all at once
+//
+// Everything comes from one block, which is allocated up front
+// If the block runs out, overflow blocks are taken from the heap, and the next
+// reset() replaces them all with a single block big enough to hold the lot,
+// so after the first lifetime the arena stops touching the heap
+class Arena
+{
+  // A block taken from the heap after the main block ran out
+  struct Overflow
+  {
+    Overflow* next; // The block taken before this one
+    size_t size;    // Usable bytes after the header
+  };
+
+  char* _block = nullptr;         // The main block
+  size_t _capacity = 0;           // Size of the main block, in bytes
+  size_t _used = 0;               // Bytes handed out from the main block
+  Overflow* _overflow = nullptr;  // The newest overflow block
+  size_t _overflowUsed = 0;       // Bytes handed out from the newest overflow block
+  size_t _overflowTotal = 0;      // Bytes in every overflow block
+
+public:
+  /**
+   * Parameterized Constructor
+   *
+   * @param capacity: Size of the main block, in bytes
+   */
+  Arena(size_t capacity);
+
+  // Delete copy constructor
+  Arena(const Arena&) = delete;
+
+  // Delete assignment operator
+  Arena& operator=(const Arena&) = delete;
+
+  // Destructor, frees every block
+  ~Arena();
+
+  /**
+   * Hands out memory, which stays valid until the next reset()
+   *
+   * @param size:      The number of bytes
+   * @param alignment: The alignment of the memory, a power of two
+   *
+   * @returns The memory
+   */
+  void* allocate(size_t size, size_t alignment);
+
+  /**
+   * Frees everything at once, in O(1) unless the arena overflowed
+   * Anything still using the memory must not touch it again
+   */
+  void reset();
+
+  /**
+   * Gets the bytes taken since the last reset(), counting overflow blocks in full
+   *
+   * @returns The used size
+   */
+  size_t getUsed() const
+  {
+    return _used + _overflowTotal;
+  }
+
+  /**
+   * Gets the size of the main block
+   *
+   * @returns The capacity, in bytes
+   */
+  size_t getCapacity() const
+  {
+    return _capacity;
+  }
+};
+
+#endif //! ARENA_H
@@ -1,19 +1,28 @@
 #ifndef SUPER_ARRAY_H
 #define SUPER_ARRAY_H
 
+#include "Allocator.h"      // For HeapAllocator
+#include <algorithm>        // For std::max
+#include <cstring>          // For memmove
 #include <initializer_list> // For std::initializer_list
 #include <iostream>         // For std::cout and std::endl
 #include <random>           // For RNG
 #include <time.h>           // For time()
+#include <utility>          // For std::move and std::forward
 
 // Stores a dynamic array
-template <typename T>
+//
+// Memory doubles when the array is full, and halves once it is only a quarter full,
+// so adding and removing around a boundary doesn't reallocate every time
+// Memory comes from the Allocator, see Allocator.h
+template <typename T, typename Allocator = HeapAllocator>
 class Array
 {
   T* _arr = nullptr;    // Pointer to the dynamic array
   T _garbage;           // Garbage value to return when give invalid indexes
   int _currentSize = 0; // The number of valid elements in the array
   int _maxSize = 1;     // The amount of allocated memory
+  Allocator _allocator; // Where the memory comes from
 
 public:
   /**
@@ -22,7 +31,7 @@ public:
   Array() :
     _garbage()
   {
-    _arr = new T[_maxSize];
+    _arr = _allocator.template allocate<T>(_maxSize);
   }
 
   /**
@@ -32,9 +41,23 @@ public:
    */
   Array(int size) :
     _garbage(),
-    _maxSize(size)
+    _maxSize(std::max(1, size))
   {
-    _arr = new T[_maxSize];
+    _arr = _allocator.template allocate<T>(_maxSize);
+  }
+
+  /**
+   * Parameterized Constructor
+   *
+   * @param allocator: Where the memory comes from
+   * @param size:      The amount of objects to allocate
+   */
+  explicit Array(const Allocator& allocator, int size = 1) :
+    _garbage(),
+    _maxSize(std::max(1, size)),
+    _allocator(allocator)
+  {
+    _arr = _allocator.template allocate<T>(_maxSize);
   }
 
   /**
@@ -46,7 +69,7 @@ public:
   {
     // Allocate memory based on the size of the list
     _maxSize = iList.size() + 1;
-    _arr = new T[_maxSize];
+    _arr = _allocator.template allocate<T>(_maxSize);
 
     // Add each element to the array
     for (int i = 0; i < iList.size(); i++)
@@ -57,24 +80,41 @@ public:
    * Copy Constructor
    */
   Array(const Array& copy) :
+    _garbage(),
     _currentSize(copy._currentSize),
-    _maxSize(copy._maxSize)
+    _maxSize(copy._maxSize),
+    _allocator(copy._allocator)
   {
     // Allocate new memory
-    _arr = new T[_maxSize];
+    _arr = _allocator.template allocate<T>(_maxSize);
 
     // Copy each element
     for (int i = 0; i < _currentSize; ++i)
       _arr[i] = copy._arr[i];
   }
 
+  /**
+   * Move Constructor
+   * Takes the memory of the other Array, leaving it empty
+   */
+  Array(Array&& other) noexcept :
+    _arr(other._arr),
+    _garbage(),
+    _currentSize(other._currentSize),
+    _maxSize(other._maxSize),
+    _allocator(other._allocator)
+  {
+    other._arr = nullptr;
+    other._currentSize = 0;
+    other._maxSize = 0;
+  }
+
   /**
    * Destructor
    */
   ~Array()
   {
-    if (_arr)
-      delete[] _arr;
+    _allocator.deallocate(_arr, _maxSize);
   }
 
   /**
@@ -88,20 +128,46 @@ public:
       return *this;
 
     // Delete the old memory
-    delete[] _arr;
+    _allocator.deallocate(_arr, _maxSize);
 
     // Copy members
     _currentSize = copy._currentSize;
     _maxSize = copy._maxSize;
 
     // Allocate new memory and copy the elements
-    _arr = new T[_maxSize];
+    _arr = _allocator.template allocate<T>(_maxSize);
     for (int i = 0; i < _currentSize; ++i)
       _arr[i] = copy._arr[i];
 
     return *this;
   }
 
+  /**
+   * Move assignment operator
+   * Takes the memory of the other Array, leaving it empty
+   *
+   * @param other: The Array to move from
+   */
+  Array& operator=(Array&& other) noexcept
+  {
+    if (this == &other)
+      return *this;
+
+    _allocator.deallocate(_arr, _maxSize);
+
+    // The memory has to go back to where it came from, so take the allocator too
+    _arr = other._arr;
+    _currentSize = other._currentSize;
+    _maxSize = other._maxSize;
+    _allocator = other._allocator;
+
+    other._arr = nullptr;
+    other._currentSize = 0;
+    other._maxSize = 0;
+
+    return *this;
+  }
+
   /**
    * Assignment operator with initiliazer list
    *
@@ -110,14 +176,14 @@ public:
   Array& operator=(const std::initializer_list<T>& iList)
   {
     // Delete the old memory
-    delete[] _arr;
+    _allocator.deallocate(_arr, _maxSize);
 
     // Set the size to 0
     _currentSize = 0;
 
     // Set max size based on list length and allocate memory
     _maxSize = iList.size() + 1;
-    _arr = new T[_maxSize];
+    _arr = _allocator.template allocate<T>(_maxSize);
 
     // Add each element to the array
     for (int i = 0; i < iList.size(); i++)
@@ -146,7 +212,7 @@ public:
    *
    * @param n: The index to return
    */
-  T operator[](int n) const
+  const T& operator[](int n) const
   {
     // Check if index is valid
     if (n < _currentSize and n >= 0)
@@ -156,6 +222,26 @@ public:
     return _garbage;
   }
 
+  /**
+   * Gets an element without checking the index, for hot loops
+   *
+   * @param n: The index to return, must be from 0 to getSize() - 1
+   */
+  T& unchecked(int n)
+  {
+    return _arr[n];
+  }
+
+  /**
+   * Gets an element without checking the index, for hot loops
+   *
+   * @param n: The index to return, must be from 0 to getSize() - 1
+   */
+  const T& unchecked(int n) const
+  {
+    return _arr[n];
+  }
+
   /**
    * The beginning of the array
    *
@@ -206,6 +292,27 @@ public:
     return _currentSize;
   }
 
+  /**
+   * Gets the number of elements that fit before the array grows
+   *
+   * @returns The amount of allocated memory
+   */
+  int getCapacity() const
+  {
+    return _maxSize;
+  }
+
+  /**
+   * Allocates memory for at least a number of elements, so adding them doesn't reallocate
+   *
+   * @param capacity: The number of elements to make room for
+   */
+  void reserve(int capacity)
+  {
+    if (capacity > _maxSize)
+      resize(capacity);
+  }
+
   /**
    * Gets a random number to index the array
    *
@@ -232,29 +339,16 @@ public:
     if (n < 0 or n > _currentSize)
       return;
 
-    // Optimize for inserting into the end
-    if (n == _currentSize)
-    {
-      if (_currentSize == _maxSize)
-        grow();
-      // Assign the value
-      _arr[n] = value;
-
-      // Increment size, and check if new memory needs to be allocated
-      _currentSize++;
-      return;
-    }
+    // Make room before shifting, the last element moves into the new space
+    if (_currentSize == _maxSize)
+      grow();
 
     // Shift all elements up to the inserting index back one
     for (int i = _currentSize; i > n; --i)
-      _arr[i] = _arr[i - 1];
+      _arr[i] = std::move(_arr[i - 1]);
 
-    if (_currentSize == _maxSize)
-      grow();
     // Assign the value
     _arr[n] = value;
-
-    // Increment size, and check if new memory needs to be allocated
     _currentSize++;
   }
 
@@ -275,7 +369,39 @@ public:
    */
   void pushBack(const T& value)
   {
-    insert(value, _currentSize);
+    if (_currentSize == _maxSize)
+      grow();
+    _arr[_currentSize++] = value;
+  }
+
+  /**
+   * Adds an element to the back of the array, moving it in
+   *
+   * @param value: The element to be inserted
+   */
+  void pushBack(T&& value)
+  {
+    if (_currentSize == _maxSize)
+      grow();
+    _arr[_currentSize++] = std::move(value);
+  }
+
+  /**
+   * Builds an element at the back of the array
+   *
+   * @param args: Passed to the element's constructor
+   *
+   * @returns The new element
+   */
+  template <typename... Args>
+  T& emplaceBack(Args&&... args)
+  {
+    if (_currentSize == _maxSize)
+      grow();
+
+    // Elements are already default constructed, so move the new one over the top
+    _arr[_currentSize] = T(std::forward<Args>(args)...);
+    return _arr[_currentSize++];
   }
 
   /**
@@ -291,14 +417,14 @@ public:
 
     // Decrement current size and save the value to be removed
     _currentSize--;
-    T temp = _arr[n];
+    T temp = std::move(_arr[n]);
 
     // Shift all elements after index forward one
     for (int i = n; i < _currentSize; ++i)
-      _arr[i] = _arr[i + 1];
+      _arr[i] = std::move(_arr[i + 1]);
 
-    // Check if memory can be deallocated
-    if (_maxSize > 1 and _currentSize <= _maxSize / 2)
+    // Only give memory back once the array is a quarter full, so it is still half full after shrinking
+    if (_maxSize > 1 and _currentSize <= _maxSize / 4)
       shrink();
 
     // Return the removed value
@@ -371,13 +497,14 @@ public:
   }
 
   /**
-   * Empties the array
+   * Empties the array, keeping its memory for reuse
    */
   void clear()
   {
-    // Remove elements until size is zero
-    while (_currentSize > 0)
-      popBack();
+    // Reset the elements, in case they hold resources
+    for (int i = 0; i < _currentSize; ++i)
+      _arr[i] = T();
+    _currentSize = 0;
   }
 
 private:
@@ -386,19 +513,7 @@ private:
    */
   void grow()
   {
-    // Double the max size and allocate new memory
-    _maxSize *= 2;
-    T* temp = new T[_maxSize];
-
-    // Copy old array to new array
-    for (int i = 0; i < _currentSize; ++i)
-      temp[i] = _arr[i];
-
-    // Deallocate old memory
-    delete[] _arr;
-
-    // Assign new pointer to array
-    _arr = temp;
+    resize(std::max(1, _maxSize * 2));
   }
 
   /**
@@ -406,17 +521,26 @@ private:
    */
   void shrink()
   {
-    // Halve the max size and allocate new memory
-    _maxSize = std::max(1, _maxSize / 2);
-    T* temp = new T[_maxSize];
+    resize(std::max(1, _maxSize / 2));
+  }
+
+  /**
+   * Moves the elements into newly allocated memory
+   *
+   * @param maxSize: The number of elements to allocate
+   */
+  void resize(int maxSize)
+  {
+    T* temp = _allocator.template allocate<T>(maxSize);
 
-    // Copy elements from old array
+    // Move elements from old array
     for (int i = 0; i < _currentSize; ++i)
-      temp[i] = _arr[i];
+      temp[i] = std::move(_arr[i]);
 
-    // Delete old array and copy the new one
-    delete[] _arr;
+    // Delete old array and use the new one
+    _allocator.deallocate(_arr, _maxSize);
     _arr = temp;
+    _maxSize = maxSize;
   }
 
   /**
@@ -0,0 +1,147 @@
+#include "ColumnStreamer.h"
+#include <chrono> // For std::chrono::milliseconds
+
+/**
+ * Parameterized Constructor, starts the worker
+ *
+ * @param data:   The level to read, must outlive the streamer
+ * @param column: The first column to read
+ */
+ColumnStreamer::ColumnStreamer(const LevelData& data, int column) :
+  _cursor(data, column),
+  _columnCount(data.getColumnCount()),
+  _readyColumns(column),
+  _stop(false),
+  _pause(false),
+  _paused(false)
+{
+  _worker = std::thread(&ColumnStreamer::run, this);
+}
+
+// Destructor, stops the worker
+ColumnStreamer::~ColumnStreamer()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop.store(true);
+  }
+  _wake.notify_all();
+  _worker.join();
+}
+
+/**
+ * Gets the next object to spawn for a column
+ * Waits for the worker if it hasn't finished the column yet
+ *
+ * @param column: The column being spawned
+ * @param spawn:  Set to the next object in the column
+ *
+ * @returns False once every object in the column has been returned
+ */
+bool ColumnStreamer::next(int column, Spawn& spawn)
+{
+  if (column >= _columnCount)
+    return false;
+
+  // The worker is far ahead in normal play, so this only waits if it stalled
+  while (true)
+  {
+    // Check the progress first, every record of a ready column is already queued
+    bool ready = _readyColumns.load(std::memory_order_acquire) > column;
+
+    const SpawnRecord* record = _records.front();
+    if (record and record->column <= column)
+    {
+      spawn = record->spawn;
+      _records.pop();
+      return true;
+    }
+
+    if (ready)
+      return false;
+
+    std::this_thread::yield();
+  }
+}
+
+/**
+ * Drops everything queued and starts reading again from a column, on the same worker
+ * Only call from the thread that calls next()
+ *
+ * @param data:   The level to read, must outlive the streamer
+ * @param column: The first column to read
+ */
+void ColumnStreamer::restart(const LevelData& data, int column)
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  // Wait for the worker to stop pushing, so the queue only has this thread left on it
+  _pause.store(true);
+  _wake.notify_all();
+  _wake.wait(lock, [this] { return _paused; });
+
+  while (_records.front())
+    _records.pop();
+
+  _cursor.reset(data, column);
+  _columnCount = data.getColumnCount();
+  _readyColumns.store(column, std::memory_order_relaxed);
+
+  _pause.store(false);
+  _wake.notify_all();
+}
+
+/**
+ * Queues columns until told to stop, runs on the worker thread
+ */
+void ColumnStreamer::run()
+{
+  while (true)
+  {
+    fill();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    // Let a restart know the queue is free, then wait for it to hand over the new cursor
+    if (_pause.load())
+    {
+      _paused = true;
+      _wake.notify_all();
+      _wake.wait(lock, [this] { return not _pause.load() or _stop.load(); });
+      _paused = false;
+    }
+    // At the end of the level, sleep until a restart or the destructor
+    else if (not _stop.load())
+      _wake.wait(lock, [this] { return _pause.load() or _stop.load(); });
+
+    if (_stop.load())
+      return;
+  }
+}
+
+/**
+ * Queues columns from the cursor until the end of the level, or until told to stop or pause
+ */
+void ColumnStreamer::fill()
+{
+  while (not _cursor.atEnd() and not _stop.load(std::memory_order_relaxed) and
+         not _pause.load(std::memory_order_relaxed))
+  {
+    int column = _cursor.getColumn();
+
+    for (const Spawn& i : _cursor.next())
+    {
+      SpawnRecord record = {column, i};
+
+      // Wait for the game to catch up when the queue is full
+      while (not _records.push(record))
+      {
+        if (_stop.load(std::memory_order_relaxed) or _pause.load(std::memory_order_relaxed))
+          return;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+
+    _readyColumns.store(column + 1, std::memory_order_release);
+  }
+}
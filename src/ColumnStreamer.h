@@ -0,0 +1,89 @@
+#ifndef COLUMN_STREAMER_H
+#define COLUMN_STREAMER_H
+
+#include "LevelData.h"        // For LevelData and LevelCursor classes
+#include "SpscRing.h"         // For SpscRing class
+#include <atomic>             // For std::atomic
+#include <condition_variable> // For std::condition_variable
+#include <mutex>              // For std::mutex and std::unique_lock
+#include <thread>             // For std::thread
+
+// An object to spawn, tagged with the column it belongs to
+struct SpawnRecord
+{
+  int column;  // The column of the object
+  Spawn spawn; // The object
+};
+
+// Reads the columns of a level on a worker thread, ahead of the game
+//
+// The worker touches the level data (and so any mapped pages) and queues
+// a SpawnRecord for every object, so the main thread only pops ready records
+// Once it reaches the end it waits, so a restart reuses the same thread
+class ColumnStreamer
+{
+  // Enough records for several screens of even the densest columns
+  static const unsigned CAPACITY = 4096;
+
+  LevelCursor _cursor;                      // Reads the level, only used by the worker
+  int _columnCount;                         // How many columns are in the level
+  SpscRing<SpawnRecord, CAPACITY> _records; // Records waiting to be spawned
+  std::atomic<int> _readyColumns;           // Columns that have been fully queued
+  std::atomic<bool> _stop;                  // Tells the worker to exit
+  std::atomic<bool> _pause;                 // Tells the worker to wait for a restart
+  bool _paused;                             // Set by the worker once it is waiting, guarded by _mutex
+  std::mutex _mutex;                        // Guards handing the worker a new cursor
+  std::condition_variable _wake;            // Signals changes to _stop, _pause and _paused
+  std::thread _worker;                      // Fills the queue
+
+public:
+  /**
+   * Parameterized Constructor, starts the worker
+   *
+   * @param data:   The level to read, must outlive the streamer
+   * @param column: The first column to read
+   */
+  ColumnStreamer(const LevelData& data, int column = 0);
+
+  // Delete copy constructor
+  ColumnStreamer(const ColumnStreamer&) = delete;
+
+  // Delete assignment operator
+  ColumnStreamer& operator=(const ColumnStreamer&) = delete;
+
+  // Destructor, stops the worker
+  ~ColumnStreamer();
+
+  /**
+   * Gets the next object to spawn for a column
+   * Waits for the worker if it hasn't finished the column yet
+   *
+   * @param column: The column being spawned
+   * @param spawn:  Set to the next object in the column
+   *
+   * @returns False once every object in the column has been returned
+   */
+  bool next(int column, Spawn& spawn);
+
+  /**
+   * Drops everything queued and starts reading again from a column, on the same worker
+   * Only call from the thread that calls next()
+   *
+   * @param data:   The level to read, must outlive the streamer
+   * @param column: The first column to read
+   */
+  void restart(const LevelData& data, int column);
+
+private:
+  /**
+   * Queues columns until told to stop, runs on the worker thread
+   */
+  void run();
+
+  /**
+   * Queues columns from the cursor until the end of the level, or until told to stop or pause
+   */
+  void fill();
+};
+
+#endif //! COLUMN_STREAMER_H
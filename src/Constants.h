@@ -1,9 +1,8 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
 
-#include "ICS_Color.h" // For ICS_Color
-#include <string>      // For std::string
-#include <utility>     // For std::pair<>
+#include <string>  // For std::string
+#include <utility> // For std::pair<>
 
 // Make a Vertex "class" to reduce verbosity
 #define Vertex std::pair<double, double>
@@ -18,9 +17,16 @@ const int SCREEN_BLOCKS_HEIGHT = 12; // Height of the game window in blocks
 const int WINDOW_WIDTH = PIXELS_PER_BLOCK * SCREEN_BLOCKS_WIDTH;   // Width of the game window in pixels
 const int WINDOW_HEIGHT = PIXELS_PER_BLOCK * SCREEN_BLOCKS_HEIGHT; // Height of the game window in pixels
 
-// Number of frames that a jump buffers for
-// Give user a 100ms buffer for jumping (6/60fps = 100ms)
-const int JUMP_FRAMES = 6;
+// The game logic runs in fixed steps, so the result doesn't depend on the frame rate
+const int SIMULATION_RATE = 240;                      // Steps per second
+const double SIMULATION_STEP = 1.0 / SIMULATION_RATE; // Seconds per step
+
+// Most steps run in one update, after a longer stall the game slows down instead of catching up
+const int MAX_STEPS_PER_UPDATE = SIMULATION_RATE / 4;
+
+// How long a jump buffers for, in seconds
+// Give user a 100ms buffer for jumping (24 steps at 240 steps per second)
+const double JUMP_BUFFER_TIME = 0.1;
 
 // Physics constants
 
@@ -39,6 +45,26 @@ const double SCROLL_SPEED_PIXELS = SCROLL_SPEED * PIXELS_PER_BLOCK;
 const double TERMINAL_VELOCITY_PIXELS = TERMINAL_VELOCITY * PIXELS_PER_BLOCK;             // Pixels per seconds
 const double BACKGROUND_SCROLL_SPEED_PIXELS = BACKGROUND_SCROLL_SPEED * PIXELS_PER_BLOCK; // Pixels per seconds
 
+// Read level columns on a worker thread ahead of the game, instead of when they are due
+// Keeps level reads (and page faults on the mapped level) off the main thread
+const bool STREAM_LEVEL_COLUMNS = false;
+
+// Save a replay of every attempt that ends, next to the level, see Replay.h
+// Check them with the replay tool to catch physics changes
+const bool RECORD_REPLAYS = false;
+
+// How far the camera moves before level coordinates are shifted back towards 0, in pixels
+// Keeps the float positions of objects precise however long the level is
+const double CAMERA_REBASE_DISTANCE = 65536;
+
+// Width of the cells objects are bucketed into for collisions, in pixels
+// Objects wider than a cell, or off the block grid, still work, queries just cover more cells
+const double COLLISION_CELL_WIDTH = PIXELS_PER_BLOCK;
+
+// Starting size of the arena the containers of a Level come from, in bytes
+// The arena grows to fit on the next Level if a level needs more
+const int LEVEL_ARENA_SIZE = 256 * 1024;
+
 // Time screen pauses after player dies
 const double DEATH_PAUSE_LENGTH = 0.2;
 
@@ -62,6 +88,4 @@ const std::string PLAYER_IMAGE_FILE = "data/player.bmp";
 const std::string SPIKE_FILE_NAME = "data/spike.png";
 const std::string LEVEL_COMPLETE_FILE_NAME = "data/level_complete.png";
 
-const ICS_Color END_MENU_TEXT_COLOUR = ICS_Color(253, 208, 48);
-
 #endif //! CONSTANTS_H
@@ -1,24 +1,25 @@
 #include "GeometryDash.h"
+#include "AllocationCounter.h" // For getAllocationCount
+#include <chrono>              // For std::chrono::steady_clock
+#include <iostream>            // For std::cout
 
-// Default Constructor
-GeometryDash::GeometryDash()
+/**
+ * Parameterized Constructor
+ *
+ * @param startColumn: The column of the level every attempt starts from
+ *                     Non zero values are for practice runs
+ */
+GeometryDash::GeometryDash(int startColumn) :
+  _watcher(_levelName),
+  _startColumn(startColumn),
+  _arena(LEVEL_ARENA_SIZE)
 {
-  // Attempt to open the level file, and check if it opened
-  std::ifstream inFile(_levelName + ".lvl");
-  if (not inFile.is_open())
-  {
-    std::cout << "Could not open " << _levelName << ".lvl\n";
-  }
-  else
-  {
-    // Loop through the file and count the lines
-    std::string line = "";
-    for (; std::getline(inFile, line); _lines++)
-      ;
+  // Load the layout once, every attempt reads from the same copy
+  _levelData = new LevelData;
+  if (_levelData->load(_levelName))
+    createLevel(*_levelData);
 
-    // Allocate the new level
-    _level = new Level(_levelName, _attempts, _lines);
-  }
+  _attemptAllocations = getAllocationCount();
 }
 
 // Destructor
@@ -26,6 +27,8 @@ GeometryDash::~GeometryDash()
 {
   if (_level)
     delete _level;
+
+  delete _levelData;
 }
 
 /**
@@ -35,6 +38,10 @@ GeometryDash::~GeometryDash()
  */
 void GeometryDash::update(double elapsed)
 {
+  // Pick up any edits to the level
+  if (_watcher.poll())
+    reload();
+
   // Check if the game is paused after a death
 
   // If there is more time left on the timer than has passed
@@ -74,11 +81,62 @@ void GeometryDash::handleKeyEvent(int key, int eventType)
  */
 void GeometryDash::restart()
 {
+  // Once the pools and containers have warmed up, an attempt shouldn't touch the heap
+  uint64_t allocations = getAllocationCount();
+  if (ALLOCATIONS_COUNTED)
+    std::cout << "Attempt " << _attempts << " made " << allocations - _attemptAllocations << " heap allocations\n";
+
   _pauseTimer = 0.0;
   _attempts++;
 
-  // Deallocate and create a new level
+  // Start the level again in place, so nothing has to be loaded again
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
   if (_level)
-    delete _level;
-  _level = new Level(_levelName, _attempts, _lines);
+    _level->reset(_attempts);
+  else
+    createLevel(*_levelData);
+
+  // Report how long the restart took, it should be well under a millisecond
+  double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "Attempt " << _attempts << " restarted in " << milliseconds << " ms";
+  if (ALLOCATIONS_COUNTED)
+    std::cout << ", " << getAllocationCount() - allocations << " heap allocations";
+  std::cout << "\n";
+
+  _attemptAllocations = getAllocationCount();
+}
+
+/**
+ * Loads the edited layout of the level, and patches it into the running attempt
+ */
+void GeometryDash::reload()
+{
+  // Keep playing the old layout if the edit doesn't load, e.g. a half written file
+  LevelData* data = new LevelData;
+  if (not data->load(_levelName))
+  {
+    delete data;
+    return;
+  }
+
+  if (_level)
+    _level->patch(*data);
+  else
+    createLevel(*data);
+
+  // Nothing reads the old layout any more
+  delete _levelData;
+  _levelData = data;
+}
+
+/**
+ * Builds the Level, from an empty arena
+ *
+ * @param data: The layout of the level
+ */
+void GeometryDash::createLevel(const LevelData& data)
+{
+  // Nothing else uses the arena, so everything from the last Level can go at once
+  _arena.reset();
+  _level = new Level(data, _pools, _sprites, _arena, _attempts, _startColumn);
 }
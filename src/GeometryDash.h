@@ -1,20 +1,37 @@
 #ifndef GEOMETRY_DASH_H
 #define GEOMETRY_DASH_H
 
-#include "Level.h" // For Level class
+#include "Arena.h"         // For Arena class
+#include "Level.h"         // For Level class
+#include "LevelData.h"     // For LevelData class
+#include "LevelWatcher.h"  // For LevelWatcher class
+#include "ObjectPools.h"   // For ObjectPools class
+#include "ObjectSprites.h" // For ObjectSprites class
+#include <cstdint>         // For uint64_t
 
 // Represents a simple game of Geometry Dash
 class GeometryDash
 {
   double _pauseTimer = 0.0;                       // How long has the level been paused after an attempt
   int _attempts = 1;                              // Total attemps for this level
-  int _lines = 1;                                 // How many lines is the level file
-  Level* _level = nullptr;                        // The level being rendered
   std::string _levelName = "data/stereo_madness"; // The name of the level
+  LevelData* _levelData = nullptr;                // The layout of the level, shared by every attempt
+  LevelWatcher _watcher;                          // Notices when the level files are edited
+  int _startColumn = 0;                           // The column every attempt starts from
+  ObjectPools _pools;                             // Objects reused by every attempt
+  ObjectSprites _sprites;                         // Sprites reused by every attempt
+  Arena _arena;                                   // Where the containers of the Level come from, reset for each Level
+  Level* _level = nullptr;                        // The level being rendered
+  uint64_t _attemptAllocations = 0;               // Heap allocations counted when the attempt started
 
 public:
-  // Default Constructor
-  GeometryDash();
+  /**
+   * Parameterized Constructor
+   *
+   * @param startColumn: The column of the level every attempt starts from
+   *                     Non zero values are for practice runs
+   */
+  GeometryDash(int startColumn = 0);
 
   // Delete the copy constructor
   GeometryDash(const GeometryDash&) = delete;
@@ -45,6 +62,18 @@ private:
    * Restarts the level
    */
   void restart();
+
+  /**
+   * Loads the edited layout of the level, and patches it into the running attempt
+   */
+  void reload();
+
+  /**
+   * Builds the Level, from an empty arena
+   *
+   * @param data: The layout of the level
+   */
+  void createLevel(const LevelData& data);
 };
 
 #endif //! GEOMETRY_DASH_H
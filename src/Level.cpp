@@ -1,21 +1,31 @@
 #include "Level.h"
-#include "Block.h"
 #include "ICS_Game.h"
-#include "LevelEnd.h"
-#include "Platform.h"
-#include "Spike.h"
-#include "itos.h"
-#include <sstream>
-
-// Delete copy constructor
-Level::Level(std::string name, int attempts, int length) :
-  _name(name),
-  _file(name + ".lvl"),
-  _background(name + ".png", WINDOW_WIDTH * 6.0, WINDOW_HEIGHT * 2.0),
+#include <cstdio>   // For snprintf
+#include <iostream> // For std::cout
+#include <string>   // For std::to_string
+
+// Colour of the text on the end menu
+const ICS_Color END_MENU_TEXT_COLOUR = ICS_Color(253, 208, 48);
+
+/**
+ * Level Constructor
+ *
+ * @param data:        The layout of the Level, must outlive the Level
+ * @param pools:       Where to get objects from, must outlive the Level
+ * @param sprites:     Draws the objects, must outlive the Level
+ * @param arena:       Where the containers of the Level come from, must outlive the Level
+ * @param attempts:    Which attempt is this
+ * @param startColumn: The column of the layout to start from, for practice runs
+ */
+Level::Level(const LevelData& data, ObjectPools& pools, ObjectSprites& sprites, Arena& arena, int attempts, int startColumn) :
+  _simulation(data, pools, arena, startColumn),
+  _sprites(sprites),
+  _background(data.getName() + ".png", WINDOW_WIDTH * 6.0, WINDOW_HEIGHT * 2.0),
   _attemptText("data/PUSAB___.otf", 44),
   _endMenu(LEVEL_COMPLETE_FILE_NAME, END_MENU_WIDTH_PIXELS, END_MENU_HEIGHT_PIXELS),
   _endText("data/PUSAB___.otf", 34),
-  _endText2("data/PUSAB___.otf", 44)
+  _endText2("data/PUSAB___.otf", 44),
+  _player(PLAYER_IMAGE_FILE, PIXELS_PER_BLOCK, PIXELS_PER_BLOCK)
 {
   // Set up all of the UI
 
@@ -30,50 +40,69 @@ Level::Level(std::string name, int attempts, int length) :
   _endText.setAnchor(0.5, 0.5);
   _endText.setPriority(1001);
 
-  _endText2.setVisible(false);
   _endText2.setColor(END_MENU_TEXT_COLOUR);
   _endText2.setPosition(ICS_Pair<float>(WINDOW_WIDTH / 2.0, WINDOW_HEIGHT / 2.0 - 44));
-  _endText2.setText("Attemps " + itos(attempts));
   _endText2.setAnchor(0.5, 0.5);
   _endText2.setPriority(1001);
 
-  _attemptText.setText("Attempt " + itos(attempts));
   _attemptText.setPriority(1000);
   _attemptText.setColor(255, 255, 255);
-  _attemptText.setPosition(WINDOW_WIDTH / 2.5, WINDOW_HEIGHT / 4.0);
 
   _background.setPriority(-999);
 
-  // Add enough objects to make a starting platform for the player
-  for (int i = 0; i <= SCREEN_BLOCKS_WIDTH + 1; ++i)
-    _objects.pushBack(new Block(Vertex(PIXELS_PER_BLOCK * i, WINDOW_HEIGHT - PIXELS_PER_BLOCK / 2)));
+  _player.setX(PLAYER_STARTING_POS.first);
 
-  // Print error message if the level file couldn't be opened
-  if (not _file.is_open())
-  {
-    std::cout << "Could not open " << name << ".lvl\n";
-  }
-  // Add the end to the level
-  else
-  {
-    _end = new LevelEnd(Vertex(WINDOW_WIDTH + length * PIXELS_PER_BLOCK + PIXELS_PER_BLOCK, WINDOW_HEIGHT / 2));
-  }
+  // Hashing walks the whole layout, so only do it when the hash is needed
+  if (RECORD_REPLAYS)
+    _levelHash = hashLayout(data);
+
+  // Everything else is set up the same way for every attempt
+  reset(attempts);
 }
 
 // Destructor
 Level::~Level()
 {
-  // Close the level file
-  _file.close();
+  // Give the sprites back, the Simulation gives the objects back
+  _sprites.clear();
+}
 
-  // Deallocate all of the objects
-  for (auto i : _objects)
-    if (i)
-      delete i;
+/**
+ * Starts the Level again, reusing everything it has already loaded
+ *
+ * @param attempts: Which attempt is this
+ */
+void Level::reset(int attempts)
+{
+  // The objects are about to be cleared, so give their sprites back first
+  _sprites.clear();
+  _simulation.reset();
 
-  // Delete the LevelEnd
-  if (_end)
-    delete _end;
+  _accumulator = 0.0;
+  _drawnOrigin = 0.0;
+  _atEnd = false;
+  _restart = false;
+
+  _attempt = attempts;
+  _patched = false;
+  if (RECORD_REPLAYS)
+    _replay.start(_levelHash, SIMULATION_STEP, _simulation.getStartColumn());
+
+  // Put the UI back
+  _endMenu.setVisible(false);
+  _endText.setVisible(false);
+  _endText2.setVisible(false);
+
+  // Format into the stack, the strings are short enough not to allocate either
+  char text[32];
+  snprintf(text, sizeof(text), "Attemps %d", attempts);
+  _endText2.setText(text);
+  snprintf(text, sizeof(text), "Attempt %d", attempts);
+  _attemptText.setText(text);
+  _attemptText.setPosition(WINDOW_WIDTH / 2.5, WINDOW_HEIGHT / 4.0);
+
+  // Start with the camera at the start of the level
+  render(0.0);
 }
 
 /**
@@ -95,11 +124,8 @@ void Level::handleKeyPress(int key, int eventType)
   case ICS_KEY_W:
   case ICS_KEY_UP:
     // If they pressed it, then they are jumping
-    if (eventType == ICS_EVENT_PRESS)
-      _jumping = true;
     // Otherwise they released it, and stopped bouncing
-    else
-      _jumping = false;
+    setJumping(eventType == ICS_EVENT_PRESS);
     break;
   case ICS_KEY_SPACE:
     // If they press space at the end of the level, then restart
@@ -110,21 +136,14 @@ void Level::handleKeyPress(int key, int eventType)
     // Otherwise, apply jump logic as normal
     else
     {
-      if (eventType == ICS_EVENT_PRESS)
-        _jumping = true;
-      else
-        _jumping = false;
+      setJumping(eventType == ICS_EVENT_PRESS);
       break;
     }
   };
-
-  // If the player is jumping, then queue a jump
-  if (_jumping)
-    _player.jump();
 }
 
 /**
- * Updates the Level
+ * Updates the Level, running every step that is due
  *
  * @param elapsed: The time since the last update
  *
@@ -133,7 +152,7 @@ void Level::handleKeyPress(int key, int eventType)
 bool Level::update(double elapsed)
 {
   // If the player wants to restart, then pretend that they died
-  // The game will then create a new Level
+  // The game will then restart the Level
   if (_restart)
     return true;
 
@@ -141,95 +160,116 @@ bool Level::update(double elapsed)
   if (_atEnd)
     return false;
 
-  // Update the end
-  _end->update(elapsed, _objects);
-
-  // Move the attempt text and background
-  _attemptText.setX(_attemptText.getX() - SCROLL_SPEED * PIXELS_PER_BLOCK * elapsed);
-  _background.setX(_background.getX() - BACKGROUND_SCROLL_SPEED_PIXELS * elapsed);
+  // Run every step that has come due, a slow frame runs more steps instead of longer ones
+  // After a long stall, drop the time that can't be caught up rather than freezing to catch up
+  _accumulator += elapsed;
+  if (_accumulator > MAX_STEPS_PER_UPDATE * SIMULATION_STEP)
+    _accumulator = MAX_STEPS_PER_UPDATE * SIMULATION_STEP;
 
-  // Update each object, and remove them if they are off of the screen
-  for (int i = 0; i < _objects.getSize(); ++i)
+  while (_accumulator >= SIMULATION_STEP)
   {
-    if (_objects[i]->update(elapsed, _objects))
+    _accumulator -= SIMULATION_STEP;
+
+    StepResult result = _simulation.step();
+
+    // If they player died, then show where they died and return true
+    if (result == STEP_DIED)
     {
-      delete _objects[i];
-      _objects.remove(i);
-      i--;
+      saveReplay(result);
+      render(1.0);
+      return true;
+    }
+
+    // If they are at the end
+    if (result == STEP_FINISHED)
+    {
+      saveReplay(result);
+      _atEnd = true;
+      render(1.0);
+
+      // Show the menu
+      _endText.setVisible(true);
+      _endText2.setVisible(true);
+      _endMenu.setVisible(true);
+
+      // Return false, because the player didn't die
+      return false;
     }
   }
 
-  // If they player died, then return true
-  if (_player.update(elapsed, _objects))
-    return true;
+  // Draw between the last two steps, by the time left over
+  render(_accumulator / SIMULATION_STEP);
 
-  // Calculate how far the player is from the end
-  double distToEnd = _end->getX() - _player.getX();
+  return false;
+}
 
-  // If they are at the end
-  if (distToEnd < _end->getWidth() / 2 + _player.getWidth() / 2)
-  {
-    _atEnd = true;
+/**
+ * Switches to an edited layout without restarting
+ * Columns that have already spawned are left alone, every later column comes from the new layout
+ *
+ * @param data: The new layout, must outlive the Level
+ */
+void Level::patch(const LevelData& data)
+{
+  _simulation.patch(data);
 
-    // Show the menu
-    _endText.setVisible(true);
-    _endText2.setVisible(true);
-    _endMenu.setVisible(true);
+  // The attempt so far was on the old layout, later attempts are on the new one
+  _patched = true;
+  if (RECORD_REPLAYS)
+    _levelHash = hashLayout(data);
+}
 
-    // Return false, because the player didn't die
-    return false;
-  }
+/**
+ * Presses or releases jump, recording it in the replay
+ *
+ * @param jumping: True if jump is held
+ */
+void Level::setJumping(bool jumping)
+{
+  if (RECORD_REPLAYS)
+    _replay.record(_simulation.getStep(), jumping);
 
-  // Track time since level start
-  _elapsed += elapsed;
+  _simulation.setJumping(jumping);
+}
 
-  // If enough time has passed, load another block
-  if (_elapsed / SECONDS_PER_BLOCK > _blockCounter)
-  {
-    _blockCounter++;
-    loadColumn();
-  }
+/**
+ * Saves the replay of the attempt, if replays are recorded
+ *
+ * @param result: How the attempt ended
+ */
+void Level::saveReplay(StepResult result)
+{
+  if (not RECORD_REPLAYS or _patched)
+    return;
 
-  // If the player is jumping, queue a jump
-  if (_jumping)
-    _player.jump();
+  _replay.finish(result, _simulation.getStep());
 
-  return false;
+  std::string path = _simulation.getData().getName() + "_" + std::to_string(_attempt) + REPLAY_EXTENSION;
+  if (_replay.save(path))
+    std::cout << "Saved replay " << path << "\n";
 }
 
 /**
- * Loads a columnn from the file
+ * Draws the Level between the last two steps
+ *
+ * @param alpha: How far through the step, from 0 (the previous step) to 1 (the last step)
  */
-void Level::loadColumn()
+void Level::render(double alpha)
 {
-  // Get the line from the file
-  std::string line = "";
-  std::getline(_file, line);
-  std::stringstream ss;
-  ss << line;
-
-  // Get each object from the line
-  while (std::getline(ss, line, '|'))
+  // Move the sprites along with the objects if the Simulation shifted them back
+  if (_simulation.getOrigin() != _drawnOrigin)
   {
-    std::stringstream ss2;
-    ss2 << line;
-    // Get the position
-    std::getline(ss2, line, ' ');
-    double x = WINDOW_WIDTH + _blockCounter * PIXELS_PER_BLOCK - _elapsed * PIXELS_PER_BLOCK * SCROLL_SPEED + PIXELS_PER_BLOCK;
-    double y = atof(line.c_str()) * PIXELS_PER_BLOCK + PIXELS_PER_BLOCK / 2;
-    Vertex pos(x, y);
-
-    // Get the type
-    std::getline(ss2, line, ' ');
-
-    // Allocate a new object based on type
-    if (line == "block")
-      _objects.pushBack(new Block(pos));
-    else if (line == "spike")
-      _objects.pushBack(new Spike(pos));
-    else if (line == "platform")
-      _objects.pushBack(new Platform(pos));
-    else
-      std::cout << "There was an invalid object type in level file.\n\n";
+    _sprites.shift(_simulation.getOrigin() - _drawnOrigin);
+    _drawnOrigin = _simulation.getOrigin();
   }
+
+  // Scroll every object at once, drawing objects that have reached the screen
+  _sprites.draw(_simulation.getObjects(), _simulation.getCameraX(alpha));
+
+  _player.setY(_simulation.getPlayer().getRenderY(alpha));
+
+  // Move the attempt text and background
+  double time = _simulation.getTime(alpha);
+  _attemptText.setX(WINDOW_WIDTH / 2.5 - SCROLL_SPEED_PIXELS * time);
+  _background.setX(-BACKGROUND_SCROLL_SPEED_PIXELS * time);
 }
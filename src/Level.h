@@ -1,20 +1,25 @@
 #ifndef LEVEL_H
 #define LEVEL_H
 
-#include "ICS_Text.h" // For ICS_Text class
-#include "LevelEnd.h" // For LevelEnd class
-#include "Object.h"   // For Object class
-#include "Player.h"   // For Player class
-#include <fstream>    // For ifstream
-
+#include "Arena.h"         // For Arena class
+#include "ICS_Sprite.h"    // For ICS_Sprite class
+#include "ICS_Text.h"      // For ICS_Text class
+#include "LevelData.h"     // For LevelData class
+#include "ObjectPools.h"   // For ObjectPools class
+#include "ObjectSprites.h" // For ObjectSprites class
+#include "Replay.h"        // For Replay class
+#include "Simulation.h"    // For Simulation class
+
+// A Level being played
+//
+// The game logic runs in fixed steps in a Simulation, however long each frame is
+// The Level feeds it input and draws it, between its last two steps
 class Level
 {
-  Array<Object*> _objects;   // The objects in the Level
-  Player _player = Player(); // The player in the Level
-  LevelEnd* _end = nullptr;  // The end of the Level
-
-  std::string _name;   // Name of the Level
-  std::ifstream _file; // File with the Level layout
+  Simulation _simulation;    // The game logic of the Level
+  ObjectSprites& _sprites;   // Draws the objects that are on the screen
+  double _accumulator = 0.0; // Time that has passed but hasn't been stepped yet, in seconds
+  double _drawnOrigin = 0.0; // The origin of the Simulation when the sprites were placed
 
   // Text objects
 
@@ -26,23 +31,30 @@ class Level
 
   ICS_Sprite _background; // Background of Level
   ICS_Sprite _endMenu;    // Menu at the end of Level
+  ICS_Sprite _player;     // The player
 
-  double _elapsed = 0.0; // How much time, in second, has elapsed since the start
-  int _blockCounter = 0; // How many blocks have been rendered, not including the beginning platform
-
-  bool _jumping = false; // Is the player jumping
   bool _atEnd = false;   // It the player at the end
   bool _restart = false; // Did the player choose to restart
 
+  // Replays, only when RECORD_REPLAYS is on
+
+  Replay _replay;          // The inputs of this attempt
+  uint64_t _levelHash = 0; // hashLayout() of the layout being played
+  int _attempt = 0;        // Which attempt this is, to name the replay
+  bool _patched = false;   // Was the layout edited during this attempt, so it can't be replayed
+
 public:
   /**
    * Level Constructor
    *
-   * @param name:     The name of the Level
-   * @param attempts: Which attempt is this
-   * @param length:   How many blocks is the level
+   * @param data:        The layout of the Level, must outlive the Level
+   * @param pools:       Where to get objects from, must outlive the Level
+   * @param sprites:     Draws the objects, must outlive the Level
+   * @param arena:       Where the containers of the Level come from, must outlive the Level
+   * @param attempts:    Which attempt is this
+   * @param startColumn: The column of the layout to start from, for practice runs
    */
-  Level(std::string name, int attempts, int length);
+  Level(const LevelData& data, ObjectPools& pools, ObjectSprites& sprites, Arena& arena, int attempts, int startColumn = 0);
 
   // Delete copy constructor
   Level(const Level&) = delete;
@@ -53,6 +65,13 @@ public:
   // Destructor
   ~Level();
 
+  /**
+   * Starts the Level again, reusing everything it has already loaded
+   *
+   * @param attempts: Which attempt is this
+   */
+  void reset(int attempts);
+
   /**
    * Handles any key presses by the user
    *
@@ -62,7 +81,7 @@ public:
   void handleKeyPress(int key, int eventType);
 
   /**
-   * Updates the Level
+   * Updates the Level, running every step that is due
    *
    * @param elapsed: The time since the last update
    *
@@ -71,9 +90,34 @@ public:
   bool update(double elapsed);
 
   /**
-   * Loads a columnn from the file
+   * Switches to an edited layout without restarting
+   * Columns that have already spawned are left alone, every later column comes from the new layout
+   *
+   * @param data: The new layout, must outlive the Level
+   */
+  void patch(const LevelData& data);
+
+private:
+  /**
+   * Presses or releases jump, recording it in the replay
+   *
+   * @param jumping: True if jump is held
+   */
+  void setJumping(bool jumping);
+
+  /**
+   * Saves the replay of the attempt, if replays are recorded
+   *
+   * @param result: How the attempt ended
+   */
+  void saveReplay(StepResult result);
+
+  /**
+   * Draws the Level between the last two steps
+   *
+   * @param alpha: How far through the step, from 0 (the previous step) to 1 (the last step)
    */
-  void loadColumn();
+  void render(double alpha);
 };
 
 #endif //! LEVEL_H
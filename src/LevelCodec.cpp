@@ -0,0 +1,241 @@
+#include "LevelCodec.h"
+#include <cstring> // For memcpy
+
+// Matches shorter than this cost more to encode than the literals
+const size_t MIN_MATCH = 4;
+
+// Matches can only reach this far back, the offset is 2 bytes
+const size_t MAX_OFFSET = 65535;
+
+// Size of the table used to find matches, as a power of two
+const int HASH_BITS = 12;
+
+/**
+ * Reads 4 bytes for hashing
+ *
+ * @param source: The bytes to read
+ *
+ * @returns The bytes as an integer
+ */
+static uint32_t read32(const uint8_t* source)
+{
+  uint32_t value;
+  memcpy(&value, source, sizeof(value));
+  return value;
+}
+
+/**
+ * Hashes the 4 bytes a match would start with
+ *
+ * @param value: The bytes to hash
+ *
+ * @returns An index into the match table
+ */
+static uint32_t hashMatch(uint32_t value)
+{
+  return (value * 2654435761u) >> (32 - HASH_BITS);
+}
+
+/**
+ * Writes a count that didn't fit in its token nibble
+ *
+ * @param dest:  Where to write the count
+ * @param count: The count, minus the 15 already stored in the nibble
+ *
+ * @returns One past the last byte written
+ */
+static uint8_t* writeCount(uint8_t* dest, size_t count)
+{
+  for (; count >= 255; count -= 255)
+    *dest++ = 255;
+  *dest++ = static_cast<uint8_t>(count);
+  return dest;
+}
+
+/**
+ * Reads a count that didn't fit in its token nibble
+ *
+ * @param source: The next compressed byte, moved past the count
+ * @param end:    One past the last compressed byte
+ * @param count:  The count from the nibble, added to
+ *
+ * @returns False if the data ended in the middle of the count
+ */
+static bool readCount(const uint8_t*& source, const uint8_t* end, size_t& count)
+{
+  uint8_t byte;
+  do
+  {
+    if (source >= end)
+      return false;
+    byte = *source++;
+    count += byte;
+  } while (byte == 255);
+
+  return true;
+}
+
+/**
+ * Writes one sequence
+ *
+ * @param dest:     Where to write the sequence
+ * @param literals: The first literal byte
+ * @param count:    The number of literals
+ * @param offset:   Distance back to the match, ignored if length is 0
+ * @param length:   Length of the match, or 0 for the last sequence
+ *
+ * @returns One past the last byte written
+ */
+static uint8_t* writeSequence(uint8_t* dest, const uint8_t* literals, size_t count, size_t offset, size_t length)
+{
+  size_t matchNibble = length ? length - MIN_MATCH : 0;
+  uint8_t* token = dest++;
+  *token = static_cast<uint8_t>((count < 15 ? count : 15) << 4 | (matchNibble < 15 ? matchNibble : 15));
+
+  if (count >= 15)
+    dest = writeCount(dest, count - 15);
+  memcpy(dest, literals, count);
+  dest += count;
+
+  if (length)
+  {
+    *dest++ = static_cast<uint8_t>(offset & 0xFF);
+    *dest++ = static_cast<uint8_t>(offset >> 8);
+    if (matchNibble >= 15)
+      dest = writeCount(dest, matchNibble - 15);
+  }
+
+  return dest;
+}
+
+/**
+ * Gets the largest size some data could compress to
+ *
+ * @param size: The number of bytes to compress
+ *
+ * @returns The space compressBytes needs for its output
+ */
+size_t compressBound(size_t size)
+{
+  // All literals: a token, the count bytes and the literals themselves
+  return size + size / 255 + 16;
+}
+
+/**
+ * Gets the largest size some compressed data could decompress to
+ *
+ * @param size: The number of compressed bytes
+ *
+ * @returns The most bytes decompressBytes could write
+ */
+size_t decompressBound(size_t size)
+{
+  // Each extra count byte adds at most 255 to a match, which no other byte beats
+  return size * 255;
+}
+
+/**
+ * Compresses some bytes
+ *
+ * @param source: The bytes to compress
+ * @param size:   The number of bytes to compress
+ * @param dest:   Where to write the compressed bytes, at least compressBound(size) bytes
+ *
+ * @returns The number of compressed bytes
+ */
+size_t compressBytes(const uint8_t* source, size_t size, uint8_t* dest)
+{
+  // Last position each hash was seen at, plus one so zero means empty
+  uint32_t table[1 << HASH_BITS] = {};
+
+  uint8_t* out = dest;
+  size_t literalStart = 0;
+  size_t i = 0;
+
+  while (size >= MIN_MATCH and i <= size - MIN_MATCH)
+  {
+    uint32_t value = read32(source + i);
+    uint32_t hash = hashMatch(value);
+    size_t candidate = table[hash];
+    table[hash] = static_cast<uint32_t>(i + 1);
+
+    // Check the candidate really matches and is close enough
+    if (candidate == 0 or i - (candidate - 1) > MAX_OFFSET or read32(source + candidate - 1) != value)
+    {
+      i++;
+      continue;
+    }
+    candidate--;
+
+    // Extend the match as far as it goes
+    size_t length = MIN_MATCH;
+    while (i + length < size and source[candidate + length] == source[i + length])
+      length++;
+
+    out = writeSequence(out, source + literalStart, i - literalStart, i - candidate, length);
+    i += length;
+    literalStart = i;
+  }
+
+  // Finish with the remaining literals
+  out = writeSequence(out, source + literalStart, size - literalStart, 0, 0);
+  return static_cast<size_t>(out - dest);
+}
+
+/**
+ * Decompresses some bytes, checking every read and write against the buffer sizes
+ *
+ * @param source:   The compressed bytes
+ * @param size:     The number of compressed bytes
+ * @param dest:     Where to write the decompressed bytes
+ * @param destSize: The exact number of decompressed bytes expected
+ *
+ * @returns False if the data is corrupt
+ */
+bool decompressBytes(const uint8_t* source, size_t size, uint8_t* dest, size_t destSize)
+{
+  const uint8_t* end = source + size;
+  uint8_t* out = dest;
+  uint8_t* outEnd = dest + destSize;
+
+  while (source < end)
+  {
+    uint8_t token = *source++;
+
+    // Copy the literals
+    size_t count = token >> 4;
+    if (count == 15 and not readCount(source, end, count))
+      return false;
+    if (count > static_cast<size_t>(end - source) or count > static_cast<size_t>(outEnd - out))
+      return false;
+
+    memcpy(out, source, count);
+    out += count;
+    source += count;
+
+    // The last sequence has no match
+    if (source == end)
+      break;
+
+    // Copy the match, byte by byte since it may overlap itself
+    if (end - source < 2)
+      return false;
+    size_t offset = source[0] | source[1] << 8;
+    source += 2;
+
+    size_t length = token & 15;
+    if (length == 15 and not readCount(source, end, length))
+      return false;
+    length += MIN_MATCH;
+
+    if (offset == 0 or offset > static_cast<size_t>(out - dest) or length > static_cast<size_t>(outEnd - out))
+      return false;
+
+    const uint8_t* match = out - offset;
+    for (size_t j = 0; j < length; ++j)
+      out[j] = match[j];
+    out += length;
+  }
+
+  return out == outEnd;
+}
@@ -0,0 +1,58 @@
+#ifndef LEVEL_CODEC_H
+#define LEVEL_CODEC_H
+
+#include <cstddef> // For size_t
+#include <cstdint> // For uint8_t
+
+// A small, fast LZ77 codec for the chunks of a chunked level
+//
+// The compressed data is a list of sequences, each one being
+//   token               high nibble: literal count, low nibble: match length - 4
+//   [extra count bytes] when a nibble is 15, bytes of 255 are added until one is less than 255
+//   literals            copied straight to the output
+//   offset              2 bytes, little endian, distance back to the match (not in the last sequence)
+//   [extra length bytes]
+// The last sequence only holds literals, and ends the data
+
+/**
+ * Gets the largest size some data could compress to
+ *
+ * @param size: The number of bytes to compress
+ *
+ * @returns The space compressBytes needs for its output
+ */
+size_t compressBound(size_t size);
+
+/**
+ * Gets the largest size some compressed data could decompress to
+ *
+ * @param size: The number of compressed bytes
+ *
+ * @returns The most bytes decompressBytes could write
+ */
+size_t decompressBound(size_t size);
+
+/**
+ * Compresses some bytes
+ *
+ * @param source: The bytes to compress
+ * @param size:   The number of bytes to compress
+ * @param dest:   Where to write the compressed bytes, at least compressBound(size) bytes
+ *
+ * @returns The number of compressed bytes
+ */
+size_t compressBytes(const uint8_t* source, size_t size, uint8_t* dest);
+
+/**
+ * Decompresses some bytes, checking every read and write against the buffer sizes
+ *
+ * @param source:   The compressed bytes
+ * @param size:     The number of compressed bytes
+ * @param dest:     Where to write the decompressed bytes
+ * @param destSize: The exact number of decompressed bytes expected
+ *
+ * @returns False if the data is corrupt
+ */
+bool decompressBytes(const uint8_t* source, size_t size, uint8_t* dest, size_t destSize);
+
+#endif //! LEVEL_CODEC_H
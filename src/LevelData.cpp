@@ -0,0 +1,401 @@
+#include "LevelData.h"
+#include "LevelCodec.h"  // For decompressBytes
+#include "LevelParser.h" // For LevelParser class
+#include <algorithm>     // For std::min and std::max
+#include <climits>       // For INT_MAX
+#include <cstring>       // For memcpy
+#include <iostream>      // For std::cout
+
+/**
+ * Checks that a compiled level was built after the last edit of its text file
+ *
+ * @param path: The compiled level
+ * @param text: The text file it was compiled from
+ *
+ * @returns False if it doesn't exist, or the text file was written after it
+ */
+static bool isCurrent(const std::string& path, const std::string& text)
+{
+  int64_t compiled, edited;
+  if (not getModifiedTime(path, compiled))
+    return false;
+
+  // Compiled levels shipped without their text file are always current
+  if (not getModifiedTime(text, edited) or compiled >= edited)
+    return true;
+
+  std::cout << path << " is older than " << text << ", skipping it until it is recompiled\n";
+  return false;
+}
+
+/**
+ * Checks that some objects could have come from a text level
+ *
+ * @param spawns: The first object
+ * @param count:  How many objects there are
+ *
+ * @returns False if any has an unknown type or a row past the bottom of the screen
+ */
+static bool areValidSpawns(const Spawn* spawns, size_t count)
+{
+  for (size_t i = 0; i < count; ++i)
+    if (spawns[i].type >= OBJECT_TYPE_COUNT or spawns[i].y >= LEVEL_ROWS)
+      return false;
+  return true;
+}
+
+/**
+ * Loads a level, preferring the chunked layout, then the compiled layout, then the text file
+ * Compiled layouts older than the text file are skipped, so an edit is never hidden by a stale build
+ *
+ * @param name: The name of the level, without an extension
+ *
+ * @returns True if the level was loaded
+ */
+bool LevelData::load(const std::string& name)
+{
+  std::string text = name + ".lvl";
+  std::string chunked = name + CHUNKED_LEVEL_EXTENSION;
+  std::string compiled = name + COMPILED_LEVEL_EXTENSION;
+
+  _name = name;
+  _loaded = (isCurrent(chunked, text) and loadChunked(chunked)) or
+            (isCurrent(compiled, text) and loadCompiled(compiled)) or loadText(text);
+
+  if (not _loaded)
+    std::cout << "Could not load " << name << ".lvl\n";
+
+  return _loaded;
+}
+
+/**
+ * Finds the dictionary entry of a column in the run table
+ *
+ * @param column: The column index
+ *
+ * @returns The dictionary entry used by the column
+ */
+int LevelData::findEntry(int column) const
+{
+  // Binary search for the last stored run start at or before the column
+  int low = 0;
+  int high = _runStartCount - 1;
+  while (low < high)
+  {
+    int middle = (low + high + 1) / 2;
+    if (_runStarts[middle] <= static_cast<uint32_t>(column))
+      low = middle;
+    else
+      high = middle - 1;
+  }
+
+  // Then add up the runs after it until one covers the column, loading checked that one does
+  int run = low * RUN_BLOCK_SIZE;
+  uint32_t next = _runStarts[low] + _runs[run].columns;
+  while (next <= static_cast<uint32_t>(column))
+    next += _runs[++run].columns;
+
+  return _runs[run].entry;
+}
+
+/**
+ * Maps a compiled level and validates its layout
+ *
+ * @param path: The compiled level file
+ *
+ * @returns True if the level was opened
+ */
+bool LevelData::loadCompiled(const std::string& path)
+{
+  if (not _file.open(path))
+    return false;
+
+  // Check the header before trusting any of the sizes in it
+  const LevelFileHeader* header = reinterpret_cast<const LevelFileHeader*>(_file.getData());
+  if (_file.getSize() < sizeof(LevelFileHeader) or header->magic != COMPILED_LEVEL_MAGIC or
+      header->version != COMPILED_LEVEL_VERSION)
+  {
+    std::cout << path << " is not a compiled level\n";
+    _file.close();
+    return false;
+  }
+
+  // Make sure every section fits in the file
+  size_t offsetBytes = (static_cast<size_t>(header->entryCount) + 1) * sizeof(uint32_t);
+  size_t spawnBytes = (static_cast<size_t>(header->spawnCount) * sizeof(Spawn) + 3) & ~static_cast<size_t>(3);
+  size_t runStartCount = (static_cast<size_t>(header->runCount) + RUN_BLOCK_SIZE - 1) / RUN_BLOCK_SIZE;
+  size_t runStartBytes = runStartCount * sizeof(uint32_t);
+  size_t runBytes = static_cast<size_t>(header->runCount) * sizeof(ColumnRun);
+  if (_file.getSize() < sizeof(LevelFileHeader) + offsetBytes + spawnBytes + runStartBytes + runBytes)
+  {
+    std::cout << path << " is truncated\n";
+    _file.close();
+    return false;
+  }
+
+  const char* section = _file.getData() + sizeof(LevelFileHeader);
+  const uint32_t* offsets = reinterpret_cast<const uint32_t*>(section);
+  const Spawn* spawns = reinterpret_cast<const Spawn*>(section + offsetBytes);
+  const uint32_t* runStarts = reinterpret_cast<const uint32_t*>(section + offsetBytes + spawnBytes);
+  const ColumnRun* runs = reinterpret_cast<const ColumnRun*>(section + offsetBytes + spawnBytes + runStartBytes);
+
+  // The offsets must only ever move forward, and stay inside the spawn table
+  bool valid = true;
+  for (uint32_t i = 0; i < header->entryCount; ++i)
+    valid = valid and offsets[i] <= offsets[i + 1] and offsets[i + 1] <= header->spawnCount;
+
+  // The objects must be ones a text level could hold, the same as the parser checks
+  valid = valid and areValidSpawns(spawns, header->spawnCount);
+
+  // The runs must use real entries, cover every column exactly, and agree with the stored starts
+  uint64_t column = 0;
+  for (uint32_t i = 0; i < header->runCount; ++i)
+  {
+    if (i % RUN_BLOCK_SIZE == 0)
+      valid = valid and runStarts[i / RUN_BLOCK_SIZE] == column;
+    valid = valid and runs[i].columns > 0 and runs[i].entry < header->entryCount;
+    column += runs[i].columns;
+  }
+  valid = valid and column == header->columnCount;
+
+  if (not valid)
+  {
+    std::cout << path << " has a corrupt column table\n";
+    _file.close();
+    return false;
+  }
+
+  _offsets = offsets;
+  _spawns = spawns;
+  _runStarts = runStarts;
+  _runs = runs;
+  _runStartCount = static_cast<int>(runStartCount);
+  _columnCount = static_cast<int>(header->columnCount);
+  return true;
+}
+
+/**
+ * Maps a chunked level and validates its chunk index
+ *
+ * @param path: The chunked level file
+ *
+ * @returns True if the level was opened
+ */
+bool LevelData::loadChunked(const std::string& path)
+{
+  if (not _file.open(path))
+    return false;
+
+  // Check the header before trusting any of the sizes in it
+  const ChunkedFileHeader* header = reinterpret_cast<const ChunkedFileHeader*>(_file.getData());
+  if (_file.getSize() < sizeof(ChunkedFileHeader) or header->magic != CHUNKED_LEVEL_MAGIC or
+      header->version != CHUNKED_LEVEL_VERSION or header->chunkColumns == 0 or header->chunkColumns > INT_MAX or
+      header->columnCount > INT_MAX)
+  {
+    std::cout << path << " is not a chunked level\n";
+    _file.close();
+    return false;
+  }
+
+  // There must be exactly enough chunks for the columns, and the index must fit
+  size_t chunkCount = (static_cast<size_t>(header->columnCount) + header->chunkColumns - 1) / header->chunkColumns;
+  if (header->chunkCount != chunkCount or
+      _file.getSize() < sizeof(ChunkedFileHeader) + chunkCount * sizeof(ChunkEntry))
+  {
+    std::cout << path << " is truncated\n";
+    _file.close();
+    return false;
+  }
+
+  const ChunkEntry* chunks = reinterpret_cast<const ChunkEntry*>(_file.getData() + sizeof(ChunkedFileHeader));
+
+  // Every chunk must be inside the file, and decompress to its counts and spawns
+  // Chunk sizes are only trusted as far as their compressed bytes could really decompress,
+  // since the cursors allocate the largest one up front
+  bool valid = true;
+  uint32_t largest = 0;
+  for (size_t i = 0; i < chunkCount; ++i)
+  {
+    size_t columns = i + 1 < chunkCount ? header->chunkColumns : header->columnCount - i * header->chunkColumns;
+    size_t expected = columns * sizeof(uint16_t) + static_cast<size_t>(chunks[i].spawnCount) * sizeof(Spawn);
+
+    valid = valid and chunks[i].offset <= _file.getSize() and
+            chunks[i].compressedSize <= _file.getSize() - chunks[i].offset and chunks[i].size == expected and
+            chunks[i].size <= decompressBound(chunks[i].compressedSize) and chunks[i].size <= header->maxChunkSize;
+    largest = std::max(largest, chunks[i].size);
+  }
+
+  // The header's largest chunk must be a real one
+  valid = valid and header->maxChunkSize <= largest;
+
+  if (not valid)
+  {
+    std::cout << path << " has a corrupt chunk index\n";
+    _file.close();
+    return false;
+  }
+
+  _chunks = chunks;
+  _chunkColumns = static_cast<int>(header->chunkColumns);
+  _maxChunkSize = largest;
+  _columnCount = static_cast<int>(header->columnCount);
+  return true;
+}
+
+/**
+ * Decompresses one chunk of a chunked level
+ *
+ * @param chunk:   The chunk index
+ * @param buffer:  Where to decompress to, at least getMaxChunkSize() bytes
+ * @param columns: Set to the number of columns in the chunk
+ *
+ * @returns False if the chunk is corrupt, or holds objects a text level couldn't
+ */
+bool LevelData::decodeChunk(int chunk, uint8_t* buffer, int& columns) const
+{
+  const ChunkEntry& entry = _chunks[chunk];
+  columns = std::min(_chunkColumns, _columnCount - chunk * _chunkColumns);
+
+  const uint8_t* source = reinterpret_cast<const uint8_t*>(_file.getData()) + entry.offset;
+  if (not decompressBytes(source, entry.compressedSize, buffer, entry.size))
+    return false;
+
+  // The column counts must add up to the objects in the chunk
+  uint32_t total = 0;
+  for (int i = 0; i < columns; ++i)
+  {
+    uint16_t count;
+    memcpy(&count, buffer + i * sizeof(uint16_t), sizeof(count));
+    total += count;
+  }
+
+  // The objects must be ones a text level could hold, the same as the parser checks
+  const Spawn* spawns = reinterpret_cast<const Spawn*>(buffer + columns * sizeof(uint16_t));
+  return total == entry.spawnCount and areValidSpawns(spawns, entry.spawnCount);
+}
+
+/**
+ * Parses a text level into memory
+ *
+ * @param path: The text level file
+ *
+ * @returns True if the level was parsed
+ */
+bool LevelData::loadText(const std::string& path)
+{
+  MappedFile text;
+  if (not text.open(path))
+    return false;
+
+  ParseError error;
+  if (not LevelParser::parse(text.getData(), text.getData() + text.getSize(), _ownedOffsets, _ownedSpawns, error))
+  {
+    std::cout << path << ":" << error.line << ":" << error.column << ": " << error.message << "\n";
+    return false;
+  }
+
+  _offsets = _ownedOffsets.begin();
+  _spawns = _ownedSpawns.begin();
+  _columnCount = _ownedOffsets.getSize() - 1;
+  return true;
+}
+
+/**
+ * Parameterized Constructor
+ *
+ * @param data:   The level to read
+ * @param column: The first column to read
+ */
+LevelCursor::LevelCursor(const LevelData& data, int column)
+{
+  reset(data, column);
+}
+
+// Destructor
+LevelCursor::~LevelCursor()
+{
+  delete[] _chunk;
+  delete[] _chunkOffsets;
+}
+
+/**
+ * Switches the cursor to another level
+ *
+ * @param data:   The level to read
+ * @param column: The next column to read
+ */
+void LevelCursor::reset(const LevelData& data, int column)
+{
+  delete[] _chunk;
+  delete[] _chunkOffsets;
+  _chunk = nullptr;
+  _chunkOffsets = nullptr;
+  _chunkIndex = -1;
+
+  _data = &data;
+  _column = column;
+
+  // Only chunked levels need somewhere to decompress to
+  if (data.isChunked())
+  {
+    _chunk = new uint8_t[data.getMaxChunkSize()];
+    _chunkOffsets = new uint32_t[static_cast<size_t>(std::min(data.getChunkColumns(), data.getColumnCount())) + 1];
+  }
+}
+
+/**
+ * Reads the next column, must not be called at the end
+ *
+ * @returns The objects in the column
+ */
+Column LevelCursor::next()
+{
+  int column = _column++;
+
+  if (not _data->isChunked())
+    return _data->getColumn(column);
+
+  // Decompress the chunk holding the column, if it isn't already
+  int chunk = column / _data->getChunkColumns();
+  if (chunk != _chunkIndex and not loadChunk(chunk))
+  {
+    Column empty = {nullptr, nullptr};
+    return empty;
+  }
+
+  int index = column - chunk * _data->getChunkColumns();
+  Column result = {_chunkSpawns + _chunkOffsets[index], _chunkSpawns + _chunkOffsets[index + 1]};
+  return result;
+}
+
+/**
+ * Decompresses a chunk, replacing the current one
+ *
+ * @param chunk: The chunk index
+ *
+ * @returns False if the chunk is corrupt
+ */
+bool LevelCursor::loadChunk(int chunk)
+{
+  _chunkIndex = -1;
+
+  int columns = 0;
+  if (not _data->decodeChunk(chunk, _chunk, columns))
+  {
+    std::cout << _data->getName() << CHUNKED_LEVEL_EXTENSION << " has a corrupt chunk " << chunk << "\n";
+    return false;
+  }
+
+  // Turn the column counts into offsets
+  _chunkOffsets[0] = 0;
+  for (int i = 0; i < columns; ++i)
+  {
+    uint16_t count;
+    memcpy(&count, _chunk + i * sizeof(uint16_t), sizeof(count));
+    _chunkOffsets[i + 1] = _chunkOffsets[i] + count;
+  }
+
+  _chunkSpawns = reinterpret_cast<const Spawn*>(_chunk + columns * sizeof(uint16_t));
+  _chunkIndex = chunk;
+  return true;
+}
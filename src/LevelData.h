@@ -0,0 +1,307 @@
+#ifndef LEVEL_DATA_H
+#define LEVEL_DATA_H
+
+#include "Array.h"       // For Array class
+#include "LevelFormat.h" // For Spawn and LevelFileHeader
+#include "MappedFile.h"  // For MappedFile class
+#include <string>        // For std::string
+
+// The objects in one column of a level
+struct Column
+{
+  const Spawn* first; // The first object in the column
+  const Spawn* last;  // One past the last object in the column
+
+  /**
+   * The beginning of the column
+   *
+   * @returns A pointer to the first object
+   */
+  const Spawn* begin() const
+  {
+    return first;
+  }
+
+  /**
+   * The end of the column
+   *
+   * @returns A pointer after the last object
+   */
+  const Spawn* end() const
+  {
+    return last;
+  }
+};
+
+// The layout of a level, loaded once and never modified
+// Compiled and chunked levels are read in place from a mapping, text levels are parsed into memory
+//
+// Columns are stored as entries of a dictionary, see LevelFormat.h
+// Text levels have one entry per column and no run table
+// Chunked levels stay compressed, and are read through a LevelCursor
+class LevelData
+{
+  std::string _name;                    // Name of the level, without an extension
+  MappedFile _file;                     // The mapped compiled or chunked level, if there is one
+  Array<uint32_t> _ownedOffsets;        // Offset table parsed from a text level
+  Array<Spawn> _ownedSpawns;            // Objects parsed from a text level
+  const uint32_t* _offsets = nullptr;   // Index of the first spawn in each entry
+  const Spawn* _spawns = nullptr;       // Every object in the dictionary
+  const uint32_t* _runStarts = nullptr; // First column of every RUN_BLOCK_SIZE-th run, if compiled
+  const ColumnRun* _runs = nullptr;     // Which entry each run of columns uses, if compiled
+  int _runStartCount = 0;               // How many run starts there are
+  const ChunkEntry* _chunks = nullptr;  // Where each chunk is stored, if chunked
+  int _chunkColumns = 0;                // How many columns are in each chunk
+  uint32_t _maxChunkSize = 0;           // The largest decompressed chunk, in bytes
+  int _columnCount = 0;                 // How many columns are in the level
+  bool _loaded = false;                 // Was a level loaded
+
+public:
+  // Default Constructor
+  LevelData() = default;
+
+  // Delete copy constructor
+  LevelData(const LevelData&) = delete;
+
+  // Delete assignment operator
+  LevelData& operator=(const LevelData&) = delete;
+
+  /**
+   * Loads a level, preferring the chunked layout, then the compiled layout, then the text file
+   * Compiled layouts older than the text file are skipped, so an edit is never hidden by a stale build
+   *
+   * @param name: The name of the level, without an extension
+   *
+   * @returns True if the level was loaded
+   */
+  bool load(const std::string& name);
+
+  /**
+   * Checks if a level is loaded
+   *
+   * @returns True if a level is loaded
+   */
+  bool isLoaded() const
+  {
+    return _loaded;
+  }
+
+  /**
+   * Gets the name of the level
+   *
+   * @returns The name of the level, without an extension
+   */
+  const std::string& getName() const
+  {
+    return _name;
+  }
+
+  /**
+   * Gets the length of the level
+   *
+   * @returns The number of columns in the level
+   */
+  int getColumnCount() const
+  {
+    return _columnCount;
+  }
+
+  /**
+   * Checks if the level is stored in compressed chunks
+   * Chunked levels can only be read with a LevelCursor
+   *
+   * @returns True if the level is chunked
+   */
+  bool isChunked() const
+  {
+    return _chunks != nullptr;
+  }
+
+  /**
+   * Gets the number of columns in each chunk of a chunked level
+   *
+   * @returns The columns per chunk
+   */
+  int getChunkColumns() const
+  {
+    return _chunkColumns;
+  }
+
+  /**
+   * Gets the size of the largest decompressed chunk of a chunked level
+   *
+   * @returns The size in bytes
+   */
+  uint32_t getMaxChunkSize() const
+  {
+    return _maxChunkSize;
+  }
+
+  /**
+   * Decompresses one chunk of a chunked level
+   *
+   * @param chunk:   The chunk index
+   * @param buffer:  Where to decompress to, at least getMaxChunkSize() bytes
+   * @param columns: Set to the number of columns in the chunk
+   *
+   * @returns False if the chunk is corrupt, or holds objects a text level couldn't
+   */
+  bool decodeChunk(int chunk, uint8_t* buffer, int& columns) const;
+
+  /**
+   * Gets the objects in a column of a level that isn't chunked
+   *
+   * @param column: The column index, must be less than getColumnCount()
+   *
+   * @returns The objects in the column
+   */
+  Column getColumn(int column) const
+  {
+    int entry = _runs ? findEntry(column) : column;
+    Column result = {_spawns + _offsets[entry], _spawns + _offsets[entry + 1]};
+    return result;
+  }
+
+private:
+  /**
+   * Finds the dictionary entry of a column in the run table
+   *
+   * @param column: The column index
+   *
+   * @returns The dictionary entry used by the column
+   */
+  int findEntry(int column) const;
+
+  /**
+   * Maps a compiled level and validates its layout
+   *
+   * @param path: The compiled level file
+   *
+   * @returns True if the level was opened
+   */
+  bool loadCompiled(const std::string& path);
+
+  /**
+   * Maps a chunked level and validates its chunk index
+   *
+   * @param path: The chunked level file
+   *
+   * @returns True if the level was opened
+   */
+  bool loadChunked(const std::string& path);
+
+  /**
+   * Parses a text level into memory
+   *
+   * @param path: The text level file
+   *
+   * @returns True if the level was parsed
+   */
+  bool loadText(const std::string& path);
+};
+
+// Reads the columns of a LevelData in order, from any starting column
+// Each cursor holds at most one decompressed chunk of a chunked level
+class LevelCursor
+{
+  const LevelData* _data = nullptr;    // The level being read
+  int _column = 0;                     // The next column to read
+  uint8_t* _chunk = nullptr;           // The decompressed chunk, if chunked
+  uint32_t* _chunkOffsets = nullptr;   // Index of the first spawn of each column in the chunk
+  const Spawn* _chunkSpawns = nullptr; // The objects in the chunk
+  int _chunkIndex = -1;                // Which chunk is decompressed, or -1 for none
+
+public:
+  /**
+   * Parameterized Constructor
+   *
+   * @param data:   The level to read
+   * @param column: The first column to read
+   */
+  LevelCursor(const LevelData& data, int column = 0);
+
+  // Delete copy constructor
+  LevelCursor(const LevelCursor&) = delete;
+
+  // Delete assignment operator
+  LevelCursor& operator=(const LevelCursor&) = delete;
+
+  // Destructor
+  ~LevelCursor();
+
+  /**
+   * Checks if every column has been read
+   *
+   * @returns True if there are no more columns
+   */
+  bool atEnd() const
+  {
+    return _column >= _data->getColumnCount();
+  }
+
+  /**
+   * Gets the level being read
+   *
+   * @returns The level
+   */
+  const LevelData& getData() const
+  {
+    return *_data;
+  }
+
+  /**
+   * Gets the index of the next column
+   *
+   * @returns The index of the column next() will return
+   */
+  int getColumn() const
+  {
+    return _column;
+  }
+
+  /**
+   * Moves the cursor to any column
+   * Only the chunk holding the column is decompressed, when it is read
+   *
+   * @param column: The next column to read
+   */
+  void seek(int column)
+  {
+    _column = column;
+  }
+
+  /**
+   * Switches the cursor to another level
+   *
+   * @param data:   The level to read
+   * @param column: The next column to read
+   */
+  void reset(const LevelData& data, int column);
+
+  /**
+   * Moves the cursor back to the start of the level
+   */
+  void rewind()
+  {
+    seek(0);
+  }
+
+  /**
+   * Reads the next column, must not be called at the end
+   *
+   * @returns The objects in the column
+   */
+  Column next();
+
+private:
+  /**
+   * Decompresses a chunk, replacing the current one
+   *
+   * @param chunk: The chunk index
+   *
+   * @returns False if the chunk is corrupt
+   */
+  bool loadChunk(int chunk);
+};
+
+#endif //! LEVEL_DATA_H
@@ -0,0 +1,127 @@
+#ifndef LEVEL_FORMAT_H
+#define LEVEL_FORMAT_H
+
+#include <cstdint> // For fixed width integers
+
+// Layout of a compiled (.lvc) level file
+//
+// All values are little endian, and every section is 4 byte aligned
+//
+//   LevelFileHeader                      magic, version and section sizes
+//   uint32_t offsets[entryCount + 1]     index of each dictionary entry's first Spawn
+//   Spawn spawns[spawnCount]             the objects of every distinct column
+//   (padding to a multiple of 4 bytes)
+//   uint32_t runStarts[runStartCount]    first column of every RUN_BLOCK_SIZE-th run
+//   ColumnRun runs[runCount]             which entry each run of columns uses, and for how many columns
+//
+// Identical columns are stored once, as a dictionary entry
+// Entry i holds spawns[offsets[i]] up to (not including) spawns[offsets[i + 1]]
+// Each run starts where the one before it ended, runStartCount is runCount / RUN_BLOCK_SIZE rounded up
+// Only the starts of every RUN_BLOCK_SIZE-th run are stored, so a column is found by a binary
+// search of those, then adding up at most RUN_BLOCK_SIZE runs
+// Runs longer than 65535 columns are split, and there can be at most 65536 entries
+
+// Layout of a chunked (.lvz) level file, for very long levels
+//
+//   ChunkedFileHeader                    magic, version and sizes
+//   ChunkEntry chunks[chunkCount]        where each chunk is stored
+//   compressed chunks                    each one compressed on its own with LevelCodec
+//
+// Every chunk holds chunkColumns columns, except the last which may hold fewer
+// A chunk decompresses to
+//   uint16_t counts[columns in chunk]    number of objects in each column
+//   Spawn spawns[spawnCount]             the objects of each column, in order
+// So any column can be read by decompressing just the one chunk that holds it
+
+// Extension of compiled level files
+const char* const COMPILED_LEVEL_EXTENSION = ".lvc";
+
+// Identifies a compiled level file ("GDLV")
+const uint32_t COMPILED_LEVEL_MAGIC = 0x564C4447;
+
+// Bumped whenever the layout changes
+const uint32_t COMPILED_LEVEL_VERSION = 3;
+
+// Runs between the stored run starts of a compiled level
+const int RUN_BLOCK_SIZE = 64;
+
+// Most dictionary entries a compiled level can hold, so an entry fits in a ColumnRun
+const int MAX_COMPILED_ENTRIES = 65536;
+
+// Extension of chunked level files
+const char* const CHUNKED_LEVEL_EXTENSION = ".lvz";
+
+// Identifies a chunked level file ("GDLZ")
+const uint32_t CHUNKED_LEVEL_MAGIC = 0x5A4C4447;
+
+// Bumped whenever the chunked layout changes
+const uint32_t CHUNKED_LEVEL_VERSION = 1;
+
+// Default number of columns in each chunk of a chunked level
+const int CHUNK_COLUMNS = 1024;
+
+// Number of rows in a level column, from the top of the screen
+const int LEVEL_ROWS = 12;
+
+// Ids for each kind of object that can appear in a level
+// These are stored in compiled levels, so only ever append to this list
+enum ObjectType : uint8_t
+{
+  OBJECT_BLOCK = 0,
+  OBJECT_SPIKE = 1,
+  OBJECT_PLATFORM = 2,
+  OBJECT_TYPE_COUNT
+};
+
+// A single object in a level column
+struct Spawn
+{
+  uint8_t type; // The ObjectType of the object
+  uint8_t y;    // The row of the object, in blocks from the top of the screen
+};
+
+// A run of identical columns in a compiled level
+struct ColumnRun
+{
+  uint16_t entry;   // The dictionary entry used by every column in the run
+  uint16_t columns; // How many columns the run covers, never 0
+};
+
+// The first bytes of a compiled level file
+struct LevelFileHeader
+{
+  uint32_t magic;       // Must be COMPILED_LEVEL_MAGIC
+  uint32_t version;     // Must be COMPILED_LEVEL_VERSION
+  uint32_t columnCount; // How many columns are in the level
+  uint32_t entryCount;  // How many distinct columns are in the dictionary
+  uint32_t spawnCount;  // How many objects are in the dictionary
+  uint32_t runCount;    // How many runs of identical columns there are
+};
+
+// The first bytes of a chunked level file
+struct ChunkedFileHeader
+{
+  uint32_t magic;        // Must be CHUNKED_LEVEL_MAGIC
+  uint32_t version;      // Must be CHUNKED_LEVEL_VERSION
+  uint32_t columnCount;  // How many columns are in the level
+  uint32_t chunkColumns; // How many columns are in each chunk
+  uint32_t chunkCount;   // How many chunks there are
+  uint32_t maxChunkSize; // The largest decompressed chunk, in bytes
+};
+
+// Where a chunk of a chunked level is stored
+struct ChunkEntry
+{
+  uint32_t offset;         // Start of the compressed chunk, from the start of the file
+  uint32_t compressedSize; // Size of the compressed chunk
+  uint32_t size;           // Size of the decompressed chunk
+  uint32_t spawnCount;     // How many objects are in the chunk
+};
+
+static_assert(sizeof(Spawn) == 2, "Spawn records must be tightly packed");
+static_assert(sizeof(ColumnRun) == 4, "ColumnRun records must be tightly packed");
+static_assert(sizeof(LevelFileHeader) == 24, "LevelFileHeader must be tightly packed");
+static_assert(sizeof(ChunkedFileHeader) == 24, "ChunkedFileHeader must be tightly packed");
+static_assert(sizeof(ChunkEntry) == 16, "ChunkEntry records must be tightly packed");
+
+#endif //! LEVEL_FORMAT_H
@@ -0,0 +1,186 @@
+#include "LevelParser.h"
+#include "ObjectTypes.h" // For LevelObjects
+
+/**
+ * Parameterized Constructor
+ *
+ * @param begin: The first character of the level text
+ * @param end:   One past the last character of the level text
+ */
+LevelParser::LevelParser(const char* begin, const char* end) :
+  _lineStart(begin),
+  _pos(begin),
+  _end(end)
+{
+}
+
+/**
+ * Counts the columns and the most objects a level could hold
+ * Used to size the output Arrays before parsing
+ *
+ * @param begin:   The first character of the level text
+ * @param end:     One past the last character of the level text
+ * @param columns: Set to the number of columns
+ * @param spawns:  Set to the most objects the columns could hold
+ */
+void LevelParser::measure(const char* begin, const char* end, int& columns, int& spawns)
+{
+  columns = 0;
+  spawns = 0;
+
+  for (const char* i = begin; i < end; ++i)
+  {
+    if (*i == '\n')
+      columns++;
+    else if (*i == '|')
+      spawns++;
+  }
+
+  // A last line without a newline is still a column
+  if (begin < end and end[-1] != '\n')
+    columns++;
+
+  // Every column holds one more object than it has separators
+  spawns += columns;
+}
+
+/**
+ * Parses a whole text level into an offset table and its objects
+ * Both Arrays are sized by measure() first, so parsing never reallocates
+ *
+ * @param begin:   The first character of the level text
+ * @param end:     One past the last character of the level text
+ * @param offsets: Replaced with the index of each column's first object, and one past the last object
+ * @param spawns:  Replaced with the objects of every column, in order
+ * @param error:   Set to where and why parsing failed
+ *
+ * @returns False if the level was malformed
+ */
+bool LevelParser::parse(const char* begin, const char* end, Array<uint32_t>& offsets, Array<Spawn>& spawns,
+                        ParseError& error)
+{
+  int columns = 0;
+  int maxSpawns = 0;
+  measure(begin, end, columns, maxSpawns);
+  offsets = Array<uint32_t>(columns + 1);
+  spawns = Array<Spawn>(maxSpawns);
+
+  LevelParser parser(begin, end);
+  while (not parser.atEnd())
+  {
+    offsets.pushBack(spawns.getSize());
+
+    if (not parser.parseColumn(spawns))
+    {
+      error = parser.getError();
+      return false;
+    }
+  }
+  offsets.pushBack(spawns.getSize());
+
+  return true;
+}
+
+/**
+ * Parses the next line, appending each of its objects
+ *
+ * @param spawns: The Array to add the objects to
+ *
+ * @returns False if the line was malformed, see getError()
+ */
+bool LevelParser::parseColumn(Array<Spawn>& spawns)
+{
+  skipBlanks();
+
+  // Empty lines are empty columns
+  while (not atLineEnd())
+  {
+    // Read the row number
+    if (*_pos < '0' or *_pos > '9')
+      return fail("expected a row number");
+
+    // Rows past the bottom of the screen are reported at the start of the number
+    const char* rowStart = _pos;
+    int row = 0;
+    for (; _pos < _end and *_pos >= '0' and *_pos <= '9'; ++_pos)
+    {
+      row = row * 10 + (*_pos - '0');
+      if (row >= LEVEL_ROWS)
+      {
+        _pos = rowStart;
+        return fail("row number is below the bottom of the screen");
+      }
+    }
+
+    // The row and the type must be separated by whitespace
+    if (_pos >= _end or (*_pos != ' ' and *_pos != '\t'))
+      return fail("expected a space after the row number");
+    skipBlanks();
+
+    // Read the type name
+    const char* name = _pos;
+    while (not atLineEnd() and *_pos != '|' and *_pos != ' ' and *_pos != '\t')
+      _pos++;
+    int length = static_cast<int>(_pos - name);
+
+    int type = LevelObjects::find(name, length);
+    if (type < 0)
+    {
+      _pos = name;
+      return fail(length == 0 ? "expected an object type" : "invalid object type");
+    }
+
+    Spawn spawn;
+    spawn.type = static_cast<uint8_t>(type);
+    spawn.y = static_cast<uint8_t>(row);
+    spawns.pushBack(spawn);
+
+    // Objects are separated by '|'
+    skipBlanks();
+    if (atLineEnd())
+      break;
+    if (*_pos != '|')
+      return fail("expected '|' between objects");
+    _pos++;
+    skipBlanks();
+
+    if (atLineEnd())
+      return fail("expected an object after '|'");
+  }
+
+  // Move to the start of the next line, accepting both \n and \r\n
+  if (_pos < _end and *_pos == '\r')
+    _pos++;
+  if (_pos < _end and *_pos == '\n')
+    _pos++;
+  else if (_pos < _end)
+    return fail("unexpected character");
+
+  _lineStart = _pos;
+  _line++;
+  return true;
+}
+
+/**
+ * Records an error at the current position
+ *
+ * @param message: What was wrong
+ *
+ * @returns False, so callers can return it directly
+ */
+bool LevelParser::fail(const char* message)
+{
+  _error.line = _line;
+  _error.column = static_cast<int>(_pos - _lineStart) + 1;
+  _error.message = message;
+  return false;
+}
+
+/**
+ * Skips spaces and tabs
+ */
+void LevelParser::skipBlanks()
+{
+  while (_pos < _end and (*_pos == ' ' or *_pos == '\t'))
+    _pos++;
+}
@@ -0,0 +1,118 @@
+#ifndef LEVEL_PARSER_H
+#define LEVEL_PARSER_H
+
+#include "Array.h"       // For Array class
+#include "LevelFormat.h" // For Spawn
+
+// Where and why a text level failed to parse
+struct ParseError
+{
+  int line = 0;             // The line of the error, starting at 1
+  int column = 0;           // The character of the error in the line, starting at 1
+  const char* message = ""; // What was wrong
+};
+
+// Tokenizes the text level format in place, one line (column) at a time
+//
+// Each line is a column of objects separated by '|', and each object is a
+// row number, below LEVEL_ROWS, followed by a type name, e.g. "11 block|10 spike"
+// Nothing is allocated while parsing, spawns are appended straight to the caller's Array
+class LevelParser
+{
+  const char* _lineStart; // The first character of the current line
+  const char* _pos;       // The next character to read
+  const char* _end;       // One past the last character
+  int _line = 1;          // The current line number
+  ParseError _error;      // The last error, if parsing failed
+
+public:
+  /**
+   * Parameterized Constructor
+   *
+   * @param begin: The first character of the level text
+   * @param end:   One past the last character of the level text
+   */
+  LevelParser(const char* begin, const char* end);
+
+  /**
+   * Counts the columns and the most objects a level could hold
+   * Used to size the output Arrays before parsing
+   *
+   * @param begin:   The first character of the level text
+   * @param end:     One past the last character of the level text
+   * @param columns: Set to the number of columns
+   * @param spawns:  Set to the most objects the columns could hold
+   */
+  static void measure(const char* begin, const char* end, int& columns, int& spawns);
+
+  /**
+   * Parses a whole text level into an offset table and its objects
+   * Both Arrays are sized by measure() first, so parsing never reallocates
+   *
+   * @param begin:   The first character of the level text
+   * @param end:     One past the last character of the level text
+   * @param offsets: Replaced with the index of each column's first object, and one past the last object
+   * @param spawns:  Replaced with the objects of every column, in order
+   * @param error:   Set to where and why parsing failed
+   *
+   * @returns False if the level was malformed
+   */
+  static bool parse(const char* begin, const char* end, Array<uint32_t>& offsets, Array<Spawn>& spawns,
+                    ParseError& error);
+
+  /**
+   * Checks if every line has been parsed
+   *
+   * @returns True if there are no more columns
+   */
+  bool atEnd() const
+  {
+    return _pos >= _end;
+  }
+
+  /**
+   * Parses the next line, appending each of its objects
+   *
+   * @param spawns: The Array to add the objects to
+   *
+   * @returns False if the line was malformed, see getError()
+   */
+  bool parseColumn(Array<Spawn>& spawns);
+
+  /**
+   * Gets the reason the last parse failed
+   *
+   * @returns The line, column and message of the error
+   */
+  const ParseError& getError() const
+  {
+    return _error;
+  }
+
+private:
+  /**
+   * Records an error at the current position
+   *
+   * @param message: What was wrong
+   *
+   * @returns False, so callers can return it directly
+   */
+  bool fail(const char* message);
+
+  /**
+   * Skips spaces and tabs
+   */
+  void skipBlanks();
+
+  /**
+   * Checks if the current character ends the line
+   *
+   * @returns True at a newline, carriage return or the end of the text
+   */
+  bool atLineEnd() const
+  {
+    return _pos >= _end or *_pos == '\n' or *_pos == '\r';
+  }
+};
+
+#endif //! LEVEL_PARSER_H
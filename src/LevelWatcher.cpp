@@ -0,0 +1,116 @@
+#include "LevelWatcher.h"
+#include "LevelFormat.h" // For the level file extensions
+#include "MappedFile.h"  // For getModifiedTime
+
+#ifdef __linux__
+#include <sys/inotify.h> // For inotify
+#include <unistd.h>      // For read and close
+#endif
+
+/**
+ * Parameterized Constructor, starts watching
+ *
+ * @param name: The name of the level, without an extension
+ */
+LevelWatcher::LevelWatcher(const std::string& name)
+{
+  // Split the name into the directory to watch and the file to look for
+  size_t slash = name.find_last_of("/\\");
+  std::string directory = slash == std::string::npos ? "." : name.substr(0, slash);
+  _fileName = slash == std::string::npos ? name : name.substr(slash + 1);
+
+  _paths[0] = name + ".lvl";
+  _paths[1] = name + COMPILED_LEVEL_EXTENSION;
+  _paths[2] = name + CHUNKED_LEVEL_EXTENSION;
+
+  // Remember the files as they are now, so only later writes count if the times are polled
+  pollTimes();
+
+#ifdef __linux__
+  _inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (_inotify < 0)
+    return;
+
+  // Watch the directory, since editors often save by renaming a new file over the old one
+  _watch = inotify_add_watch(_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+  if (_watch < 0)
+  {
+    close(_inotify);
+    _inotify = -1;
+  }
+#endif
+}
+
+// Destructor, stops watching
+LevelWatcher::~LevelWatcher()
+{
+#ifdef __linux__
+  if (_inotify >= 0)
+    close(_inotify);
+#endif
+}
+
+/**
+ * Checks for changes since the last call, without blocking
+ * Several changes, like an editor's save and a recompile, are reported once
+ *
+ * @returns True if any of the level's files were written
+ */
+bool LevelWatcher::poll()
+{
+#ifdef __linux__
+  if (_inotify >= 0)
+  {
+    bool changed = false;
+
+    // Drain every queued event
+    alignas(inotify_event) char buffer[4096];
+    ssize_t size;
+    while ((size = read(_inotify, buffer, sizeof(buffer))) > 0)
+    {
+      for (char* i = buffer; i < buffer + size;)
+      {
+        const inotify_event* event = reinterpret_cast<const inotify_event*>(i);
+        i += sizeof(inotify_event) + event->len;
+
+        if (event->len == 0)
+          continue;
+
+        // Only the level's own files matter
+        std::string file = event->name;
+        if (file == _fileName + ".lvl" or file == _fileName + COMPILED_LEVEL_EXTENSION or
+            file == _fileName + CHUNKED_LEVEL_EXTENSION)
+          changed = true;
+      }
+    }
+
+    return changed;
+  }
+#endif
+
+  // Without inotify, e.g. on Windows, look at the files themselves
+  return pollTimes();
+}
+
+/**
+ * Checks the write time of each of the level's files against the last check
+ *
+ * @returns True if any file was written, created or deleted since
+ */
+bool LevelWatcher::pollTimes()
+{
+  bool changed = false;
+  for (int i = 0; i < LEVEL_FILE_COUNT; ++i)
+  {
+    int64_t modified;
+    if (not getModifiedTime(_paths[i], modified))
+      modified = -1;
+
+    if (modified != _modified[i])
+    {
+      _modified[i] = modified;
+      changed = true;
+    }
+  }
+  return changed;
+}
@@ -0,0 +1,55 @@
+#ifndef LEVEL_WATCHER_H
+#define LEVEL_WATCHER_H
+
+#include <cstdint> // For int64_t
+#include <string>  // For std::string
+
+// How many files a level can be stored in, .lvl, .lvc and .lvz
+const int LEVEL_FILE_COUNT = 3;
+
+// Watches the files of a level for changes, so edits can be loaded while the game runs
+//
+// Uses inotify on Linux, without it (e.g. on Windows) the files' write times are compared on every poll
+class LevelWatcher
+{
+  std::string _paths[LEVEL_FILE_COUNT];     // The level's files, with their directory
+  std::string _fileName;                    // Name of the level file, without the directory or extension
+  int64_t _modified[LEVEL_FILE_COUNT] = {}; // When each file was last written, or -1 if it is missing
+  int _inotify = -1;                        // The inotify instance, or -1 if not watching
+  int _watch = -1;                          // The watch on the level's directory
+
+public:
+  /**
+   * Parameterized Constructor, starts watching
+   *
+   * @param name: The name of the level, without an extension
+   */
+  LevelWatcher(const std::string& name);
+
+  // Delete copy constructor
+  LevelWatcher(const LevelWatcher&) = delete;
+
+  // Delete assignment operator
+  LevelWatcher& operator=(const LevelWatcher&) = delete;
+
+  // Destructor, stops watching
+  ~LevelWatcher();
+
+  /**
+   * Checks for changes since the last call, without blocking
+   * Several changes, like an editor's save and a recompile, are reported once
+   *
+   * @returns True if any of the level's files were written
+   */
+  bool poll();
+
+private:
+  /**
+   * Checks the write time of each of the level's files against the last check
+   *
+   * @returns True if any file was written, created or deleted since
+   */
+  bool pollTimes();
+};
+
+#endif //! LEVEL_WATCHER_H
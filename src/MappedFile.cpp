@@ -0,0 +1,169 @@
+#include "MappedFile.h"
+
+#include <cstdio>     // For std::rename and std::remove
+#include <sys/stat.h> // For stat and fstat
+
+#ifdef _WIN32
+#include <Windows.h> // For CreateFileMapping and MapViewOfFile
+#else
+#include <fcntl.h>    // For open
+#include <sys/mman.h> // For mmap
+#include <unistd.h>   // For close
+#endif
+
+/**
+ * Gets when a file was last written
+ *
+ * @param path: The file
+ * @param time: Set to the time, in nanoseconds on Linux and seconds elsewhere
+ *
+ * @returns False if the file doesn't exist
+ */
+bool getModifiedTime(const std::string& path, int64_t& time)
+{
+  struct stat info;
+  if (stat(path.c_str(), &info) != 0)
+    return false;
+
+#ifdef __linux__
+  time = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#else
+  time = static_cast<int64_t>(info.st_mtime);
+#endif
+  return true;
+}
+
+/**
+ * Moves a finished file over another, so anything opening it sees the old file or the new one, never half of each
+ * A MappedFile of the old file keeps reading the old bytes until it is closed
+ *
+ * @param from: The finished file, deleted if it can't be moved
+ * @param to:   The file to replace, if it exists
+ *
+ * @returns False if the file couldn't be moved
+ */
+bool replaceFile(const std::string& from, const std::string& to)
+{
+#ifdef _WIN32
+  // rename() won't replace a file on Windows, and MoveFileEx only can while it is mapped
+  // because MappedFile shares it for deletion
+  bool moved = MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING);
+#else
+  bool moved = std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+
+  if (not moved)
+    std::remove(from.c_str());
+  return moved;
+}
+
+/**
+ * Parameterized Constructor
+ *
+ * @param path: The file to map
+ */
+MappedFile::MappedFile(const std::string& path)
+{
+  open(path);
+}
+
+// Destructor
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+/**
+ * Maps a file, unmapping any file that was already mapped
+ *
+ * @param path: The file to map
+ *
+ * @returns True if the file was mapped
+ */
+bool MappedFile::open(const std::string& path)
+{
+  close();
+
+#ifdef _WIN32
+  // Shared for deletion, so the tools can replace the file while the game has it mapped
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  // Empty files can't be mapped, so treat them as missing
+  LARGE_INTEGER size;
+  if (not GetFileSizeEx(file, &size) or size.QuadPart == 0)
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (not mapping)
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (not view)
+  {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+
+  _file = file;
+  _mapping = mapping;
+  _data = static_cast<const char*>(view);
+  _size = static_cast<size_t>(size.QuadPart);
+#else
+  int file = ::open(path.c_str(), O_RDONLY);
+  if (file < 0)
+    return false;
+
+  // Empty files can't be mapped, so treat them as missing
+  struct stat info;
+  if (fstat(file, &info) != 0 or info.st_size == 0)
+  {
+    ::close(file);
+    return false;
+  }
+
+  void* view = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+  // The mapping keeps its own reference to the file
+  ::close(file);
+
+  if (view == MAP_FAILED)
+    return false;
+
+  _data = static_cast<const char*>(view);
+  _size = static_cast<size_t>(info.st_size);
+#endif
+
+  return true;
+}
+
+/**
+ * Unmaps the file
+ */
+void MappedFile::close()
+{
+  if (not _data)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(_data);
+  CloseHandle(_mapping);
+  CloseHandle(_file);
+  _mapping = nullptr;
+  _file = nullptr;
+#else
+  munmap(const_cast<char*>(_data), _size);
+#endif
+
+  _data = nullptr;
+  _size = 0;
+}
@@ -0,0 +1,106 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef> // For size_t
+#include <cstdint> // For int64_t
+#include <string>  // For std::string
+
+/**
+ * Gets when a file was last written
+ *
+ * @param path: The file
+ * @param time: Set to the time, in nanoseconds on Linux and seconds elsewhere
+ *
+ * @returns False if the file doesn't exist
+ */
+bool getModifiedTime(const std::string& path, int64_t& time);
+
+// Added to the name of a file while it is written, before replaceFile() moves it into place
+const char* const TEMPORARY_FILE_EXTENSION = ".tmp";
+
+/**
+ * Moves a finished file over another, so anything opening it sees the old file or the new one, never half of each
+ * A MappedFile of the old file keeps reading the old bytes until it is closed
+ *
+ * @param from: The finished file, deleted if it can't be moved
+ * @param to:   The file to replace, if it exists
+ *
+ * @returns False if the file couldn't be moved
+ */
+bool replaceFile(const std::string& from, const std::string& to);
+
+// A read only view of a file mapped into memory
+class MappedFile
+{
+  const char* _data = nullptr; // Start of the mapped bytes
+  size_t _size = 0;            // Number of mapped bytes
+
+  void* _file = nullptr;    // Native file handle (Windows only)
+  void* _mapping = nullptr; // Native mapping handle (Windows only)
+
+public:
+  // Default Constructor
+  MappedFile() = default;
+
+  /**
+   * Parameterized Constructor
+   *
+   * @param path: The file to map
+   */
+  MappedFile(const std::string& path);
+
+  // Delete copy constructor
+  MappedFile(const MappedFile&) = delete;
+
+  // Delete assignment operator
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // Destructor
+  ~MappedFile();
+
+  /**
+   * Maps a file, unmapping any file that was already mapped
+   *
+   * @param path: The file to map
+   *
+   * @returns True if the file was mapped
+   */
+  bool open(const std::string& path);
+
+  /**
+   * Unmaps the file
+   */
+  void close();
+
+  /**
+   * Checks if a file is mapped
+   *
+   * @returns True if a file is mapped
+   */
+  bool isOpen() const
+  {
+    return _data != nullptr;
+  }
+
+  /**
+   * Gets the mapped bytes
+   *
+   * @returns A pointer to the first byte of the file
+   */
+  const char* getData() const
+  {
+    return _data;
+  }
+
+  /**
+   * Gets the size of the file
+   *
+   * @returns The number of mapped bytes
+   */
+  size_t getSize() const
+  {
+    return _size;
+  }
+};
+
+#endif //! MAPPED_FILE_H
@@ -3,39 +3,34 @@
 /**
  * Parameterized Constructor
  *
- * @param pos:        The position of the object on the screen
+ * @param pos:        The position of the object in the level
  * @param width:      The width of the image
  * @param height:     The height of the image
- * @param imageFile:  The image to load
+ * @param imageFile:  The image to draw
  *                    If left blank, defaults to no image
  */
 Object::Object(const Vertex& pos, double width, double height, std::string imageFile) :
   _width(width),
   _height(height),
-  _image(imageFile, width, height)
+  _imageFile(imageFile)
 {
-  // Hide the image if the user didnt give an image file
-  if (imageFile == "blank")
-  {
-    _image.setVisible(false);
-  }
+  // The hitbox matches the image, unless a child changes it
+  _hitbox.halfWidth = width / 2;
+  _hitbox.halfHeight = height / 2;
 
   // Set the image position
-  _image.setX(pos.first);
-  _image.setY(pos.second);
+  place(pos);
 }
 
 /**
- * Updates the object
+ * Moves the object, used when it is reused from a pool
  *
- * @param elapsed: How much time since the last update call, in seconds
- * @param objects: The array of objects in the game
+ * @param pos: The new position of the object in the level
  */
-bool Object::update(double elapsed, const Array<Object*>& objects)
+void Object::place(const Vertex& pos)
 {
-  // Move the image to the left based on delta time
-  _image.setX(_image.getX() - SCROLL_SPEED_PIXELS * elapsed);
+  _pos = pos;
 
-  // Return true if the image is off of the screen
-  return _image.getX() + _width / 2 < 0;
+  _hitbox.x = pos.first;
+  _hitbox.y = pos.second;
 }
@@ -1,18 +1,31 @@
 #ifndef OBJECT_H
 #define OBJECT_H
 
-#include "Array.h"      // For Array<> class
-#include "Constants.h"  // For Vertex macro
-#include "ICS_Sprite.h" // For ICS_Sprite
-#include <string>       // For std::string
+#include "Constants.h" // For Vertex macro
+#include <string>      // For std::string
+
+// The box an object collides with, which doesn't have to match its sprite
+struct Hitbox
+{
+  float x;          // Centre x, in pixels
+  float y;          // Centre y, in pixels
+  float halfWidth;  // Half the width, in pixels
+  float halfHeight; // Half the height, in pixels
+};
 
 // Represents an object in the game
+//
+// Only holds what the game needs to simulate the object
+// Objects have no sprite of their own, see ObjectSprites
 class Object
 {
 protected:
-  ICS_Sprite _image; // The sprite rendered on the screen
-  double _width;     // Width of the sprite
-  double _height;    // Height of the sprite
+  Vertex _pos;            // Centre of the sprite in the level
+  double _width;          // Width of the sprite
+  double _height;         // Height of the sprite
+  std::string _imageFile; // The image drawn for the object, "blank" for none
+  int _type = -1;         // The ObjectType, or -1 if it didn't come from an ObjectPools
+  Hitbox _hitbox;         // The hitbox, worked out when the object is placed
 
 public:
   // Default Constructor
@@ -21,10 +34,10 @@ public:
   /**
    * Parameterized Constructor
    *
-   * @param pos:        The position of the object on the screen
+   * @param pos:        The position of the object in the level
    * @param width:      The width of the image
    * @param height:     The height of the image
-   * @param imageFile:  The image to load
+   * @param imageFile:  The image to draw
    *                    If left blank, defaults to no image
    */
   Object(const Vertex& pos, double width, double height, std::string imageFile = "blank");
@@ -33,21 +46,81 @@ public:
   virtual ~Object() = default;
 
   /**
-   * Updates the object
+   * Moves the object, used when it is reused from a pool
+   *
+   * @param pos: The new position of the object in the level
+   */
+  virtual void place(const Vertex& pos);
+
+  /**
+   * Moves the object on the x axis, the hitbox keeps its offset from the sprite
+   *
+   * @param x: The new x position of the sprite
+   */
+  void setX(double x)
+  {
+    _hitbox.x += x - _pos.first;
+    _pos.first = x;
+  }
+
+  /**
+   * Gets the kind of the object
+   *
+   * @returns The ObjectType, or -1 if the object didn't come from an ObjectPools
+   */
+  int getType() const
+  {
+    return _type;
+  }
+
+  /**
+   * Sets the kind of the object
    *
-   * @param elapsed: How much time since the last update call, in seconds
-   * @param objects: The array of objects in the game
+   * @param type: The ObjectType
    */
-  virtual bool update(double elapsed, const Array<Object*>& objects);
+  void setType(int type)
+  {
+    _type = type;
+  }
+
+  /**
+   * Gets the hitbox, where place() and setX() last moved it
+   *
+   * @returns The hitbox
+   */
+  const Hitbox& getHitbox() const
+  {
+    return _hitbox;
+  }
+
+  /**
+   * Gets the image drawn for the object
+   *
+   * @returns The image file, or "blank" if nothing is drawn
+   */
+  const std::string& getImageFile() const
+  {
+    return _imageFile;
+  }
+
+  /**
+   * Checks if the object is drawn
+   *
+   * @returns True if the object has an image
+   */
+  bool isDrawn() const
+  {
+    return _imageFile != "blank";
+  }
 
   /**
    * Gets the image x
    *
    * @returns The image x position
    */
-  virtual double getX() const
+  double getX() const
   {
-    return _image.getX();
+    return _pos.first;
   }
 
   /**
@@ -55,9 +128,9 @@ public:
    *
    * @returns The image y position
    */
-  virtual double getY() const
+  double getY() const
   {
-    return _image.getY();
+    return _pos.second;
   }
 
   /**
@@ -65,7 +138,7 @@ public:
    *
    * @returns The image width
    */
-  virtual double getWidth() const
+  double getWidth() const
   {
     return _width;
   }
@@ -75,7 +148,7 @@ public:
    *
    * @returns The image height
    */
-  virtual double getHeight() const
+  double getHeight() const
   {
     return _height;
   }
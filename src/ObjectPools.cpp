@@ -0,0 +1,86 @@
+#include "ObjectPools.h"
+#include "Block.h"       // For Block class
+#include "ObjectTypes.h" // For LevelObjects
+#include "Platform.h"    // For Platform class
+#include "Spike.h"       // For Spike class
+
+// Destructor, deletes every pooled object
+ObjectPools::~ObjectPools()
+{
+  for (FreeList& list : _free)
+  {
+    for (int i = 0; i < list.count; ++i)
+      delete list.objects[i];
+    delete[] list.objects;
+  }
+}
+
+/**
+ * Gets an object, reusing a pooled one if there is one
+ *
+ * @param type: The ObjectType of the object
+ * @param pos:  The position of the object on the screen
+ *
+ * @returns The object, or nullptr for an invalid type
+ */
+Object* ObjectPools::acquire(int type, const Vertex& pos)
+{
+  if (type < 0 or type >= OBJECT_TYPE_COUNT)
+    return nullptr;
+
+  // Reuse the most recently pooled object
+  FreeList& list = _free[type];
+  if (list.count > 0)
+  {
+    Object* object = list.objects[--list.count];
+    object->place(pos);
+    return object;
+  }
+
+  Object* object = LevelObjects::create<Object>(type, pos);
+  object->setType(type);
+  return object;
+}
+
+/**
+ * Returns an object to its pool
+ * Objects that didn't come from acquire() are deleted
+ *
+ * @param object: The object, must not be used again by the caller
+ */
+void ObjectPools::release(Object* object)
+{
+  if (not object)
+    return;
+
+  int type = object->getType();
+  if (type < 0 or type >= OBJECT_TYPE_COUNT)
+  {
+    delete object;
+    return;
+  }
+
+  push(_free[type], object);
+}
+
+/**
+ * Adds an object to a free list, growing it if needed
+ *
+ * @param list:   The free list
+ * @param object: The object to add
+ */
+void ObjectPools::push(FreeList& list, Object* object)
+{
+  // Double the capacity, free lists never shrink so a steady state doesn't allocate
+  if (list.count == list.capacity)
+  {
+    list.capacity = list.capacity ? list.capacity * 2 : 64;
+    Object** objects = new Object*[list.capacity];
+    for (int i = 0; i < list.count; ++i)
+      objects[i] = list.objects[i];
+    delete[] list.objects;
+    list.objects = objects;
+  }
+
+  list.objects[list.count++] = object;
+}
@@ -0,0 +1,64 @@
+#ifndef OBJECT_POOLS_H
+#define OBJECT_POOLS_H
+
+#include "LevelFormat.h" // For OBJECT_TYPE_COUNT
+#include "Object.h"      // For Object class
+
+// Keeps objects that have scrolled off the screen, so they can be reused instead of reallocated
+//
+// There is a free list for each ObjectType
+// Owned by the game rather than a Level, so the objects outlive each attempt
+class ObjectPools
+{
+  // The pooled objects of one type
+  struct FreeList
+  {
+    Object** objects = nullptr; // The pooled objects
+    int count = 0;              // How many objects are pooled
+    int capacity = 0;           // How many objects fit before growing
+  };
+
+  FreeList _free[OBJECT_TYPE_COUNT]; // A free list for each ObjectType
+
+public:
+  // Default Constructor
+  ObjectPools() = default;
+
+  // Delete copy constructor
+  ObjectPools(const ObjectPools&) = delete;
+
+  // Delete assignment operator
+  ObjectPools& operator=(const ObjectPools&) = delete;
+
+  // Destructor, deletes every pooled object
+  ~ObjectPools();
+
+  /**
+   * Gets an object, reusing a pooled one if there is one
+   *
+   * @param type: The ObjectType of the object
+   * @param pos:  The position of the object on the screen
+   *
+   * @returns The object, or nullptr for an invalid type
+   */
+  Object* acquire(int type, const Vertex& pos);
+
+  /**
+   * Returns an object to its pool
+   * Objects that didn't come from acquire() are deleted
+   *
+   * @param object: The object, must not be used again by the caller
+   */
+  void release(Object* object);
+
+private:
+  /**
+   * Adds an object to a free list, growing it if needed
+   *
+   * @param list:   The free list
+   * @param object: The object to add
+   */
+  static void push(FreeList& list, Object* object);
+};
+
+#endif //! OBJECT_POOLS_H
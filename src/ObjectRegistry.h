@@ -0,0 +1,338 @@
+#ifndef OBJECT_REGISTRY_H
+#define OBJECT_REGISTRY_H
+
+#include <cstdint> // For fixed width integers
+#include <cstring> // For memcmp
+
+// Marks a slot of the name table that no name hashes to
+const uint8_t EMPTY_NAME_SLOT = 0xFF;
+
+// Returned by the seed search when no seed gives every name its own slot
+const uint32_t NO_NAME_SEED = 0xFFFFFFFF;
+
+// How many seeds the compile time search tries before giving up
+const uint32_t MAX_NAME_SEEDS = 1 << 16;
+
+/**
+ * Gets the length of a name at compile time
+ *
+ * @param name: The null terminated name
+ *
+ * @returns The number of characters before the null
+ */
+constexpr int nameLength(const char* name)
+{
+  return *name ? 1 + nameLength(name + 1) : 0;
+}
+
+/**
+ * Seeded FNV-1a hash of a name, at compile time
+ * Recursive, since constexpr functions can't loop in C++11, so it recurses once per
+ * character and is only used on the registered names, see hashNameAtRunTime()
+ *
+ * @param seed:   Changes which slot each name hashes to
+ * @param name:   The first character of the name
+ * @param length: The number of characters in the name
+ *
+ * @returns The hash
+ */
+constexpr uint32_t hashName(uint32_t seed, const char* name, int length)
+{
+  return length == 0 ? seed : hashName((seed ^ static_cast<uint8_t>(*name)) * 16777619u, name + 1, length - 1);
+}
+
+/**
+ * Seeded FNV-1a hash of a name, at run time
+ * Gives the same hash as hashName(), on names that aren't null terminated
+ *
+ * @param seed:   Changes which slot each name hashes to
+ * @param name:   The first character of the name
+ * @param length: The number of characters in the name
+ *
+ * @returns The hash
+ */
+inline uint32_t hashNameAtRunTime(uint32_t seed, const char* name, int length)
+{
+  for (int i = 0; i < length; ++i)
+    seed = (seed ^ static_cast<uint8_t>(name[i])) * 16777619u;
+  return seed;
+}
+
+/**
+ * Finds the number of slots in the name table
+ * A quarter full power of two, so a perfect seed is found in a few tries
+ *
+ * @param count: The number of names
+ * @param size:  The smallest size to consider
+ *
+ * @returns The number of slots
+ */
+constexpr int nameTableSize(int count, int size = 1)
+{
+  return size >= count * 4 ? size : nameTableSize(count, size * 2);
+}
+
+// A list of indices, used to build tables at compile time
+template <int... INDICES>
+struct IndexList
+{
+};
+
+// Builds IndexList<0, 1, ..., N - 1>
+template <int N, int... INDICES>
+struct MakeIndexList : MakeIndexList<N - 1, N - 1, INDICES...>
+{
+};
+
+template <int... INDICES>
+struct MakeIndexList<0, INDICES...>
+{
+  typedef IndexList<INDICES...> Type;
+};
+
+// Maps each slot of the name table to the kind whose name hashes there
+template <int SIZE>
+struct NameTable
+{
+  uint8_t slots[SIZE]; // The kind in each slot, or EMPTY_NAME_SLOT
+};
+
+// The compile time half of ObjectRegistry
+// Searches for a seed that hashes every kind's name to its own slot, and builds the table for it
+template <typename... Kinds>
+struct ObjectNameHash
+{
+  static constexpr int COUNT = sizeof...(Kinds);
+  static constexpr int SIZE = nameTableSize(COUNT);
+  static constexpr const char* NAMES[COUNT] = {Kinds::name()...};
+  static constexpr int LENGTHS[COUNT] = {nameLength(Kinds::name())...};
+  static constexpr int IDS[COUNT] = {Kinds::ID...};
+
+  /**
+   * Gets the slot a kind's name hashes to
+   *
+   * @param seed: The seed to hash with
+   * @param kind: The index of the kind
+   *
+   * @returns The slot
+   */
+  static constexpr int slot(uint32_t seed, int kind)
+  {
+    return hashName(seed, NAMES[kind], LENGTHS[kind]) & (SIZE - 1);
+  }
+
+  /**
+   * Checks that no later kind shares a kind's slot
+   *
+   * @param seed:  The seed to hash with
+   * @param kind:  The index of the kind
+   * @param other: The first later kind to check
+   *
+   * @returns True if the slot is unique
+   */
+  static constexpr bool unique(uint32_t seed, int kind, int other)
+  {
+    return other >= COUNT or (slot(seed, kind) != slot(seed, other) and unique(seed, kind, other + 1));
+  }
+
+  /**
+   * Checks that every kind from one onwards has its own slot
+   *
+   * @param seed: The seed to hash with
+   * @param kind: The first kind to check
+   *
+   * @returns True if the hash is perfect
+   */
+  static constexpr bool perfect(uint32_t seed, int kind = 0)
+  {
+    return kind >= COUNT or (unique(seed, kind, kind + 1) and perfect(seed, kind + 1));
+  }
+
+  /**
+   * Finds the first perfect seed in a range
+   * The range is split in half each step, so the recursion stays shallow
+   *
+   * @param first: The first seed to try
+   * @param last:  One past the last seed to try
+   *
+   * @returns The seed, or NO_NAME_SEED
+   */
+  static constexpr uint32_t findSeed(uint32_t first, uint32_t last)
+  {
+    return last - first == 1 ? (perfect(first) ? first : NO_NAME_SEED)
+                             : orSeed(findSeed(first, first + (last - first) / 2), first + (last - first) / 2, last);
+  }
+
+  /**
+   * Keeps a seed from the first half of a range, or searches the second half
+   *
+   * @param seed:  The result of searching the first half
+   * @param first: The first seed of the second half
+   * @param last:  One past the last seed of the second half
+   *
+   * @returns The seed, or NO_NAME_SEED
+   */
+  static constexpr uint32_t orSeed(uint32_t seed, uint32_t first, uint32_t last)
+  {
+    return seed != NO_NAME_SEED ? seed : findSeed(first, last);
+  }
+
+  /**
+   * Finds the kind whose name hashes to a slot
+   *
+   * @param seed:  The seed to hash with
+   * @param index: The slot
+   * @param kind:  The first kind to check
+   *
+   * @returns The kind, or EMPTY_NAME_SLOT
+   */
+  static constexpr uint8_t entry(uint32_t seed, int index, int kind = 0)
+  {
+    return kind >= COUNT ? EMPTY_NAME_SLOT : slot(seed, kind) == index ? kind : entry(seed, index, kind + 1);
+  }
+
+  /**
+   * Builds the name table
+   *
+   * @param seed: The seed to hash with
+   *
+   * @returns The table
+   */
+  template <int... INDICES>
+  static constexpr NameTable<SIZE> makeTable(uint32_t seed, IndexList<INDICES...>)
+  {
+    return NameTable<SIZE>{{entry(seed, INDICES)...}};
+  }
+
+  /**
+   * Checks that the kinds are listed in order of their ids
+   *
+   * @param kind: The first kind to check
+   *
+   * @returns True if each kind's id is its index
+   */
+  static constexpr bool inOrder(int kind = 0)
+  {
+    return kind >= COUNT or (IDS[kind] == kind and inOrder(kind + 1));
+  }
+
+  /**
+   * Finds the longest name from one kind onwards
+   *
+   * @param kind:   The first kind to check
+   * @param length: The longest length before that kind
+   *
+   * @returns The length of the longest name
+   */
+  static constexpr int longest(int kind = 0, int length = 0)
+  {
+    return kind >= COUNT ? length : longest(kind + 1, LENGTHS[kind] > length ? LENGTHS[kind] : length);
+  }
+};
+
+template <typename... Kinds>
+constexpr const char* ObjectNameHash<Kinds...>::NAMES[];
+
+template <typename... Kinds>
+constexpr int ObjectNameHash<Kinds...>::LENGTHS[];
+
+template <typename... Kinds>
+constexpr int ObjectNameHash<Kinds...>::IDS[];
+
+// Every kind of object that can appear in a level, built at compile time
+//
+// Each kind describes itself with
+//   typedef ... Class;             the class to spawn
+//   static constexpr ID;           its ObjectType
+//   static constexpr name();       its name in text levels
+// Kinds must be listed in order of their ids, so an id indexes straight into the tables
+//
+// Names are found with a perfect hash, and objects are made through a table of factories,
+// so neither costs more as kinds are added
+template <typename... Kinds>
+class ObjectRegistry
+{
+  typedef ObjectNameHash<Kinds...> Hash;
+
+public:
+  static constexpr int COUNT = sizeof...(Kinds);                      // How many kinds there are
+  static constexpr uint32_t SEED = Hash::findSeed(0, MAX_NAME_SEEDS); // Seed of the perfect hash
+  static constexpr int MAX_LENGTH = Hash::longest();                  // Length of the longest name
+
+  // The kind in each slot of the perfect hash
+  static constexpr NameTable<Hash::SIZE> TABLE = Hash::makeTable(SEED, typename MakeIndexList<Hash::SIZE>::Type());
+
+  static_assert(COUNT < EMPTY_NAME_SLOT, "Too many kinds of object for the name table");
+  static_assert(SEED != NO_NAME_SEED, "No seed gives every object name its own slot");
+  static_assert(Hash::inOrder(), "Kinds of object must be listed in order of their ids");
+
+  /**
+   * Looks up a kind of object by name
+   *
+   * @param name:   The first character of the name, doesn't need to be null terminated
+   * @param length: The number of characters in the name
+   *
+   * @returns The kind's id, or -1 if there is no kind with that name
+   */
+  static int find(const char* name, int length)
+  {
+    // Names come from level files, so anything longer than every kind's name isn't hashed at all
+    if (length < 0 or length > MAX_LENGTH)
+      return -1;
+
+    uint8_t kind = TABLE.slots[hashNameAtRunTime(SEED, name, length) & (Hash::SIZE - 1)];
+    if (kind == EMPTY_NAME_SLOT or Hash::LENGTHS[kind] != length or memcmp(Hash::NAMES[kind], name, length) != 0)
+      return -1;
+    return kind;
+  }
+
+  /**
+   * Gets the name of a kind of object
+   *
+   * @param id: The kind's id
+   *
+   * @returns The name used in text levels, or an empty string for an invalid id
+   */
+  static const char* getName(int id)
+  {
+    return id >= 0 and id < COUNT ? Hash::NAMES[id] : "";
+  }
+
+  /**
+   * Makes an object of a kind
+   *
+   * @param id:  The kind's id
+   * @param arg: Passed to the kind's constructor
+   *
+   * @returns The new object, or nullptr for an invalid id
+   */
+  template <typename Base, typename Arg>
+  static Base* create(int id, const Arg& arg)
+  {
+    typedef Base* (*Factory)(const Arg&);
+    static const Factory FACTORIES[] = {&construct<Base, typename Kinds::Class, Arg>...};
+
+    if (id < 0 or id >= COUNT)
+      return nullptr;
+    return FACTORIES[id](arg);
+  }
+
+private:
+  /**
+   * Factory for one kind of object
+   *
+   * @param arg: Passed to the constructor
+   *
+   * @returns The new object
+   */
+  template <typename Base, typename T, typename Arg>
+  static Base* construct(const Arg& arg)
+  {
+    return new T(arg);
+  }
+};
+
+template <typename... Kinds>
+constexpr NameTable<ObjectNameHash<Kinds...>::SIZE> ObjectRegistry<Kinds...>::TABLE;
+
+#endif //! OBJECT_REGISTRY_H
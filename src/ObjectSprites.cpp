@@ -0,0 +1,133 @@
+#include "ObjectSprites.h"
+
+// Destructor, deletes every unused sprite
+ObjectSprites::~ObjectSprites()
+{
+  for (FreeList& list : _free)
+  {
+    for (int i = 0; i < list.count; ++i)
+      delete list.sprites[i];
+    delete[] list.sprites;
+  }
+}
+
+/**
+ * Gets a sprite for an object, reusing an unused one if there is one
+ *
+ * @param object: The object to draw
+ *
+ * @returns The sprite, or nullptr if the object isn't drawn
+ */
+ICS_Sprite* ObjectSprites::attach(const Object& object)
+{
+  int type = object.getType();
+  if (not object.isDrawn() or type < 0 or type >= OBJECT_TYPE_COUNT)
+    return nullptr;
+
+  ICS_Sprite* sprite;
+  FreeList& list = _free[type];
+  if (list.count > 0)
+  {
+    sprite = list.sprites[--list.count];
+    sprite->setVisible(true);
+  }
+  else
+  {
+    sprite = new ICS_Sprite(object.getImageFile(), object.getWidth(), object.getHeight());
+    _world.addChild(sprite);
+  }
+
+  sprite->setPosition(object.getX(), object.getY());
+  return sprite;
+}
+
+/**
+ * Gives a sprite back once its object has left the screen
+ *
+ * @param type:   The ObjectType of the object the sprite was drawing
+ * @param sprite: The sprite, may be nullptr
+ */
+void ObjectSprites::detach(int type, ICS_Sprite* sprite)
+{
+  if (not sprite)
+    return;
+
+  if (type < 0 or type >= OBJECT_TYPE_COUNT)
+  {
+    delete sprite;
+    return;
+  }
+
+  sprite->setVisible(false);
+
+  // Double the capacity, free lists never shrink so a steady state doesn't allocate
+  FreeList& list = _free[type];
+  if (list.count == list.capacity)
+  {
+    list.capacity = list.capacity ? list.capacity * 2 : 64;
+    ICS_Sprite** sprites = new ICS_Sprite*[list.capacity];
+    for (int i = 0; i < list.count; ++i)
+      sprites[i] = list.sprites[i];
+    delete[] list.sprites;
+    list.sprites = sprites;
+  }
+
+  list.sprites[list.count++] = sprite;
+}
+
+/**
+ * Gives back the sprites of culled objects, and attaches sprites to the
+ * objects that have reached the right side of the screen
+ *
+ * @param objects: The objects to draw
+ * @param cameraX: The x of the left side of the screen, in level coordinates
+ */
+void ObjectSprites::draw(const ObjectStore& objects, double cameraX)
+{
+  // Objects before the front of the store have been culled
+  int culled = objects.getFirstSerial() - _firstSerial;
+  if (culled > _attached.getSize())
+    culled = _attached.getSize();
+  for (int i = 0; i < culled; ++i)
+    detach(_attached[i].type, _attached[i].sprite);
+  _attached.popFront(culled);
+  _firstSerial = objects.getFirstSerial();
+
+  // Objects are stored left to right, so the next one to reach the screen is right after the drawn ones
+  while (_attached.getSize() < objects.getSize())
+  {
+    const Object& object = objects.getObject(_attached.getSize());
+    if (object.getX() - object.getWidth() / 2 >= cameraX + WINDOW_WIDTH)
+      break;
+
+    Attached attached;
+    attached.sprite = attach(object);
+    attached.type = object.getType();
+    _attached.pushBack(attached);
+  }
+
+  setCamera(cameraX);
+}
+
+/**
+ * Moves every attached sprite to the left, after the objects were shifted
+ *
+ * @param distance: How far to move, in pixels
+ */
+void ObjectSprites::shift(double distance)
+{
+  for (int i = 0; i < _attached.getSize(); ++i)
+    if (_attached[i].sprite)
+      _attached[i].sprite->setX(_attached[i].sprite->getX() - distance);
+}
+
+/**
+ * Gives back every attached sprite, for when the objects are cleared
+ */
+void ObjectSprites::clear()
+{
+  for (int i = 0; i < _attached.getSize(); ++i)
+    detach(_attached[i].type, _attached[i].sprite);
+  _attached.clear();
+  _firstSerial = 0;
+}
@@ -0,0 +1,105 @@
+#ifndef OBJECT_SPRITES_H
+#define OBJECT_SPRITES_H
+
+#include "ICS_Renderable.h" // For ICS_Renderable class
+#include "ICS_Sprite.h"     // For ICS_Sprite class
+#include "LevelFormat.h"    // For OBJECT_TYPE_COUNT
+#include "Object.h"         // For Object class
+#include "ObjectStore.h"    // For ObjectStore class
+#include "RingBuffer.h"     // For RingBuffer class
+
+// Draws level objects while they are on the screen
+//
+// Objects don't own sprites, one is attached when an object scrolls onto the
+// screen and given back when it leaves, so objects further along the level
+// (or in a game with no window) have nothing to render
+// Sprites are kept in a free list for each ObjectType and reused, hidden while unused
+// Every sprite is a child of one world node, which the camera moves
+//
+// The sprites follow an ObjectStore by serial number, the objects that have
+// reached the screen are always at the front of the store
+class ObjectSprites
+{
+  // A sprite drawing one object
+  struct Attached
+  {
+    ICS_Sprite* sprite = nullptr; // The sprite, nullptr if the object isn't drawn
+    int type = -1;                // The ObjectType of the object, to give the sprite back
+  };
+
+  // The unused sprites of one type
+  struct FreeList
+  {
+    ICS_Sprite** sprites = nullptr; // The unused sprites
+    int count = 0;                  // How many sprites are unused
+    int capacity = 0;               // How many sprites fit before growing
+  };
+
+  ICS_Renderable _world;             // The parent of every sprite
+  FreeList _free[OBJECT_TYPE_COUNT]; // A free list for each ObjectType
+  RingBuffer<Attached> _attached;    // The sprites of the objects at the front of the store
+  int _firstSerial = 0;              // Serial number of the object the front sprite draws
+
+public:
+  // Default Constructor
+  ObjectSprites() = default;
+
+  // Delete copy constructor
+  ObjectSprites(const ObjectSprites&) = delete;
+
+  // Delete assignment operator
+  ObjectSprites& operator=(const ObjectSprites&) = delete;
+
+  // Destructor, deletes every unused sprite
+  ~ObjectSprites();
+
+  /**
+   * Gets a sprite for an object, reusing an unused one if there is one
+   *
+   * @param object: The object to draw
+   *
+   * @returns The sprite, or nullptr if the object isn't drawn
+   */
+  ICS_Sprite* attach(const Object& object);
+
+  /**
+   * Gives a sprite back once its object has left the screen
+   *
+   * @param type:   The ObjectType of the object the sprite was drawing
+   * @param sprite: The sprite, may be nullptr
+   */
+  void detach(int type, ICS_Sprite* sprite);
+
+  /**
+   * Gives back the sprites of culled objects, and attaches sprites to the
+   * objects that have reached the right side of the screen
+   *
+   * @param objects: The objects to draw
+   * @param cameraX: The x of the left side of the screen, in level coordinates
+   */
+  void draw(const ObjectStore& objects, double cameraX);
+
+  /**
+   * Moves every attached sprite to the left, after the objects were shifted
+   *
+   * @param distance: How far to move, in pixels
+   */
+  void shift(double distance);
+
+  /**
+   * Gives back every attached sprite, for when the objects are cleared
+   */
+  void clear();
+
+  /**
+   * Moves the camera, scrolling every sprite at once
+   *
+   * @param cameraX: The x of the left side of the screen, in level coordinates
+   */
+  void setCamera(double cameraX)
+  {
+    _world.setX(-cameraX);
+  }
+};
+
+#endif //! OBJECT_SPRITES_H
@@ -0,0 +1,240 @@
+#include "ObjectStore.h"
+#include "LevelFormat.h" // For OBJECT_PLATFORM
+#include <algorithm>     // For std::max and std::min
+
+/**
+ * Parameterized Constructor
+ *
+ * @param arena: Where the arrays come from, must outlive the store
+ */
+ObjectStore::ObjectStore(Arena& arena) :
+  _x(ArenaAllocator(arena)),
+  _y(ArenaAllocator(arena)),
+  _halfWidth(ArenaAllocator(arena)),
+  _halfHeight(ArenaAllocator(arena)),
+  _halfSprite(ArenaAllocator(arena)),
+  _flags(ArenaAllocator(arena)),
+  _objects(ArenaAllocator(arena)),
+  _cells(ArenaAllocator(arena))
+{
+}
+
+/**
+ * Adds an object to the right of every stored object
+ *
+ * @param object: The object, owned by the store until it is released
+ */
+void ObjectStore::add(Object* object)
+{
+  // Copy the hitbox worked out when the object was placed
+  const Hitbox& hitbox = object->getHitbox();
+  _x.pushBack(hitbox.x);
+  _y.pushBack(hitbox.y);
+  _halfWidth.pushBack(hitbox.halfWidth);
+  _halfHeight.pushBack(hitbox.halfHeight);
+  _halfSprite.pushBack(object->getWidth() / 2);
+
+  uint8_t flags = object->isDeadly() ? COLLIDE_DEADLY : COLLIDE_SOLID;
+  if (object->getType() == OBJECT_PLATFORM)
+    flags |= COLLIDE_PLATFORM;
+  _flags.pushBack(flags);
+
+  _objects.pushBack(object);
+
+  // Objects normally arrive in order, one that doesn't goes in the last cell,
+  // and queries reach back far enough to find it
+  int cell = getCell(hitbox.x);
+  if (_cells.getSize() == 0)
+  {
+    _firstCell = cell;
+    _cells.pushBack(_added);
+  }
+
+  int lastCell = _firstCell + _cells.getSize() - 1;
+  if (cell < lastCell)
+    cell = lastCell;
+
+  // Start every cell up to the object's, empty cells start at the same object as the next one
+  while (lastCell < cell)
+  {
+    _cells.pushBack(_added);
+    lastCell++;
+  }
+
+  // Track how far hitboxes reach past their cell, so queries cover wide and misplaced objects
+  float reach = hitbox.halfWidth + std::max(0.0, _cellOrigin + cell * COLLISION_CELL_WIDTH - hitbox.x);
+  if (reach > _reach)
+    _reach = reach;
+
+  _added++;
+}
+
+/**
+ * Moves every object to the left
+ * Only used to keep coordinates near 0, the camera does the scrolling
+ *
+ * @param distance: How far to move, in pixels
+ */
+void ObjectStore::shift(double distance)
+{
+  int size;
+  float* x = _x.getFirstPart(size);
+  for (int i = 0; i < size; ++i)
+    x[i] = static_cast<float>(x[i] - distance);
+
+  x = _x.getSecondPart(size);
+  for (int i = 0; i < size; ++i)
+    x[i] = static_cast<float>(x[i] - distance);
+
+  // Move the cells with the objects
+  _cellOrigin -= distance;
+
+  // Sprites are drawn at the centre of their hitbox on the x axis, which moves the hitbox to match
+  for (int i = 0; i < _objects.getSize(); ++i)
+    _objects[i]->setX(_x[i]);
+}
+
+/**
+ * Releases the objects that have left the left side of the screen
+ *
+ * @param cameraX: The x of the left side of the screen
+ * @param pools:   Where to release the objects to
+ */
+void ObjectStore::cull(double cameraX, ObjectPools& pools)
+{
+  // Objects are stored left to right, so the ones off the screen are at the front
+  int count = 0;
+  while (count < _x.getSize() and _x[count] + _halfSprite[count] < cameraX)
+  {
+    pools.release(_objects[count]);
+    count++;
+  }
+
+  if (count == 0)
+    return;
+
+  _x.popFront(count);
+  _y.popFront(count);
+  _halfWidth.popFront(count);
+  _halfHeight.popFront(count);
+  _halfSprite.popFront(count);
+  _flags.popFront(count);
+  _objects.popFront(count);
+
+  // Drop the cells that no longer have any objects, keeping the last so new objects stay in order
+  _removed += count;
+  while (_cells.getSize() > 1 and _cells[1] <= _removed)
+  {
+    _cells.popFront();
+    _firstCell++;
+  }
+}
+
+/**
+ * Releases every object, serial numbers start from 0 again
+ *
+ * @param pools: Where to release the objects to
+ */
+void ObjectStore::clear(ObjectPools& pools)
+{
+  for (int i = 0; i < _objects.getSize(); ++i)
+    pools.release(_objects[i]);
+
+  _x.clear();
+  _y.clear();
+  _halfWidth.clear();
+  _halfHeight.clear();
+  _halfSprite.clear();
+  _flags.clear();
+  _objects.clear();
+
+  _cells.clear();
+  _firstCell = 0;
+  _cellOrigin = -COLLISION_CELL_WIDTH / 2;
+  _reach = 0.0f;
+  _added = 0;
+  _removed = 0;
+}
+
+/**
+ * Gets the objects as contiguous runs, from left to right
+ *
+ * @param ranges: Filled with up to two runs
+ *
+ * @returns The number of runs filled in
+ */
+int ObjectStore::getRanges(ObjectRange ranges[2]) const
+{
+  return slice(0, _x.getSize(), ranges);
+}
+
+/**
+ * Gets the objects that might overlap a span of x, as contiguous runs from left to right
+ * Only whole cells are returned, so some of the objects can be outside the span
+ *
+ * @param minX:   The left of the span
+ * @param maxX:   The right of the span
+ * @param ranges: Filled with up to two runs
+ *
+ * @returns The number of runs filled in
+ */
+int ObjectStore::getRanges(double minX, double maxX, ObjectRange ranges[2]) const
+{
+  // Widen the span by the furthest reach, then find which cells it covers
+  int first = std::max(getCell(minX - _reach) - _firstCell, 0);
+  int last = std::min(getCell(maxX + _reach) - _firstCell, _cells.getSize() - 1);
+  if (first > last)
+    return slice(0, 0, ranges);
+
+  // The front cell can have had objects culled from it
+  int begin = std::max(_cells[first], _removed) - _removed;
+  int end = (last + 1 < _cells.getSize() ? _cells[last + 1] : _added) - _removed;
+  return slice(begin, end, ranges);
+}
+
+/**
+ * Gets some of the objects as contiguous runs
+ *
+ * @param begin:  Index of the first object
+ * @param end:    Index after the last object
+ * @param ranges: Filled with up to two runs
+ *
+ * @returns The number of runs filled in
+ */
+int ObjectStore::slice(int begin, int end, ObjectRange ranges[2]) const
+{
+  // Every array is pushed and popped together, so they all wrap at the same place
+  int firstSize, secondSize;
+  const float* x = _x.getFirstPart(firstSize);
+  const float* y = _y.getFirstPart(firstSize);
+  const float* halfWidth = _halfWidth.getFirstPart(firstSize);
+  const float* halfHeight = _halfHeight.getFirstPart(firstSize);
+  const uint8_t* flags = _flags.getFirstPart(firstSize);
+
+  // The part of the slice before the wrap
+  int firstEnd = std::min(end, firstSize);
+  ranges[0].x = x + begin;
+  ranges[0].y = y + begin;
+  ranges[0].halfWidth = halfWidth + begin;
+  ranges[0].halfHeight = halfHeight + begin;
+  ranges[0].flags = flags + begin;
+  ranges[0].size = std::max(firstEnd - begin, 0);
+
+  // And the part after it
+  int secondBegin = std::max(begin, firstSize) - firstSize;
+  ranges[1].x = _x.getSecondPart(secondSize) + secondBegin;
+  ranges[1].y = _y.getSecondPart(secondSize) + secondBegin;
+  ranges[1].halfWidth = _halfWidth.getSecondPart(secondSize) + secondBegin;
+  ranges[1].halfHeight = _halfHeight.getSecondPart(secondSize) + secondBegin;
+  ranges[1].flags = _flags.getSecondPart(secondSize) + secondBegin;
+  ranges[1].size = std::max(end - firstSize - secondBegin, 0);
+
+  // Keep the runs in order if the slice starts after the wrap
+  if (ranges[0].size == 0 and ranges[1].size > 0)
+  {
+    ranges[0] = ranges[1];
+    return 1;
+  }
+
+  return ranges[1].size > 0 ? 2 : 1;
+}
@@ -0,0 +1,169 @@
+#ifndef OBJECT_STORE_H
+#define OBJECT_STORE_H
+
+#include "Allocator.h"     // For ArenaAllocator class
+#include "Object.h"        // For Object class
+#include "ObjectPools.h"   // For ObjectPools class
+#include "Overlap.h"       // For ObjectRange struct and COLLIDE_ flags
+#include "RingBuffer.h"    // For RingBuffer class
+#include <cmath>           // For std::floor
+#include <cstdint>         // For uint8_t
+
+// The objects of a Level, stored as a structure of arrays
+//
+// The hitbox of every object is kept in contiguous arrays, so scrolling,
+// culling and collisions read straight through memory instead of calling
+// virtual getters on each heap object
+// Positions are in level coordinates, objects don't move once they are added
+// Objects enter on the right and leave on the left, so each array is a
+// RingBuffer and both are O(1)
+// Every object gets a serial number as it is added, so whatever draws the
+// objects can tell which ones have been culled, see ObjectSprites
+// The arrays can come from an Arena, and keep their memory between attempts
+//
+// Objects are also bucketed into columns COLLISION_CELL_WIDTH wide, by the centre
+// of their hitbox, so collisions only look at the cells an area overlaps
+// Each cell is a run of objects, so a cell only needs the index of its first object
+class ObjectStore
+{
+  RingBuffer<float, ArenaAllocator> _x;          // Centre x of each hitbox, in pixels
+  RingBuffer<float, ArenaAllocator> _y;          // Centre y of each hitbox, in pixels
+  RingBuffer<float, ArenaAllocator> _halfWidth;  // Half the width of each hitbox, in pixels
+  RingBuffer<float, ArenaAllocator> _halfHeight; // Half the height of each hitbox, in pixels
+  RingBuffer<float, ArenaAllocator> _halfSprite; // Half the width of each sprite, for culling
+  RingBuffer<uint8_t, ArenaAllocator> _flags;    // The COLLIDE_ flags of each object
+  RingBuffer<Object*, ArenaAllocator> _objects;  // The object each hitbox belongs to
+
+  RingBuffer<int, ArenaAllocator> _cells;          // Serial number of the first object in each cell, from _firstCell on
+  int _firstCell = 0;                              // The cell at the front of _cells
+  double _cellOrigin = -COLLISION_CELL_WIDTH / 2;  // Where cell 0 starts, so block aligned objects sit in the middle of a cell
+  float _reach = 0.0f;                             // Furthest a hitbox reaches past the edges of its cell, in pixels
+  int _added = 0;                                  // Serial number of the next object added
+  int _removed = 0;                                // Serial number of the front object
+
+public:
+  // Default Constructor, the arrays come from the heap
+  ObjectStore() = default;
+
+  /**
+   * Parameterized Constructor
+   *
+   * @param arena: Where the arrays come from, must outlive the store
+   */
+  explicit ObjectStore(Arena& arena);
+
+  // Delete copy constructor
+  ObjectStore(const ObjectStore&) = delete;
+
+  // Delete assignment operator
+  ObjectStore& operator=(const ObjectStore&) = delete;
+
+  /**
+   * Adds an object to the right of every stored object
+   *
+   * @param object: The object, owned by the store until it is released
+   */
+  void add(Object* object);
+
+  /**
+   * Moves every object to the left
+   * Only used to keep coordinates near 0, the camera does the scrolling
+   *
+   * @param distance: How far to move, in pixels
+   */
+  void shift(double distance);
+
+  /**
+   * Releases the objects that have left the left side of the screen
+   *
+   * @param cameraX: The x of the left side of the screen
+   * @param pools:   Where to release the objects to
+   */
+  void cull(double cameraX, ObjectPools& pools);
+
+  /**
+   * Releases every object, serial numbers start from 0 again
+   *
+   * @param pools: Where to release the objects to
+   */
+  void clear(ObjectPools& pools);
+
+  /**
+   * Gets the number of stored objects
+   *
+   * @returns The number of objects
+   */
+  int getSize() const
+  {
+    return _x.getSize();
+  }
+
+  /**
+   * Gets the serial number of the front object, which goes up as objects are culled
+   *
+   * @returns The serial number
+   */
+  int getFirstSerial() const
+  {
+    return _removed;
+  }
+
+  /**
+   * Gets an object
+   *
+   * @param n: The index from the front, from 0 to getSize() - 1
+   *
+   * @returns The object
+   */
+  const Object& getObject(int n) const
+  {
+    return *_objects[n];
+  }
+
+  /**
+   * Gets the objects as contiguous runs, from left to right
+   *
+   * @param ranges: Filled with up to two runs
+   *
+   * @returns The number of runs filled in
+   */
+  int getRanges(ObjectRange ranges[2]) const;
+
+  /**
+   * Gets the objects that might overlap a span of x, as contiguous runs from left to right
+   * Only whole cells are returned, so some of the objects can be outside the span
+   *
+   * @param minX:   The left of the span
+   * @param maxX:   The right of the span
+   * @param ranges: Filled with up to two runs
+   *
+   * @returns The number of runs filled in
+   */
+  int getRanges(double minX, double maxX, ObjectRange ranges[2]) const;
+
+private:
+  /**
+   * Finds the cell an x position is in
+   *
+   * @param x: The x position
+   *
+   * @returns The cell number
+   */
+  int getCell(double x) const
+  {
+    return static_cast<int>(std::floor((x - _cellOrigin) / COLLISION_CELL_WIDTH));
+  }
+
+  /**
+   * Gets some of the objects as contiguous runs
+   *
+   * @param begin:  Index of the first object
+   * @param end:    Index after the last object
+   * @param ranges: Filled with up to two runs
+   *
+   * @returns The number of runs filled in
+   */
+  int slice(int begin, int end, ObjectRange ranges[2]) const;
+};
+
+#endif //! OBJECT_STORE_H
@@ -0,0 +1,55 @@
+#ifndef OBJECT_TYPES_H
+#define OBJECT_TYPES_H
+
+#include "LevelFormat.h"    // For ObjectType
+#include "ObjectRegistry.h" // For ObjectRegistry
+
+// The classes are only named here, so the level tools can use the registry without the game
+class Block;
+class Platform;
+class Spike;
+
+// Every kind of object that can appear in a level
+// To add one: append its id to ObjectType, describe it below, and add it to the end of LevelObjects
+
+struct BlockType
+{
+  typedef Block Class;                           // The class spawned for this kind
+  static constexpr ObjectType ID = OBJECT_BLOCK; // The id stored in compiled levels
+
+  // The name used in text levels
+  static constexpr const char* name()
+  {
+    return "block";
+  }
+};
+
+struct SpikeType
+{
+  typedef Spike Class;                           // The class spawned for this kind
+  static constexpr ObjectType ID = OBJECT_SPIKE; // The id stored in compiled levels
+
+  // The name used in text levels
+  static constexpr const char* name()
+  {
+    return "spike";
+  }
+};
+
+struct PlatformType
+{
+  typedef Platform Class;                           // The class spawned for this kind
+  static constexpr ObjectType ID = OBJECT_PLATFORM; // The id stored in compiled levels
+
+  // The name used in text levels
+  static constexpr const char* name()
+  {
+    return "platform";
+  }
+};
+
+typedef ObjectRegistry<BlockType, SpikeType, PlatformType> LevelObjects;
+
+static_assert(LevelObjects::COUNT == OBJECT_TYPE_COUNT, "Every ObjectType must be registered in LevelObjects");
+
+#endif //! OBJECT_TYPES_H
@@ -0,0 +1,288 @@
+#include "Overlap.h"
+#include <cmath>   // For std::abs
+#include <cstring> // For std::memset
+
+// The vector kernels are only built for x86, and are compiled for their instruction set
+// function by function, so the rest of the game still runs on CPUs without them
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#define OVERLAP_VECTOR
+#include <immintrin.h> // For SSE2 and AVX2 intrinsics
+#if defined(_MSC_VER) && !defined(__clang__)
+#define OVERLAP_MSVC
+#include <intrin.h> // For __cpuid and _xgetbv
+#define VECTOR_TARGET(name)
+#else
+#include <cpuid.h> // For __get_cpuid
+#define VECTOR_TARGET(name) __attribute__((target(name)))
+#endif
+#endif
+
+/**
+ * Adds the hits of a block of hitboxes to a result
+ *
+ * @param range:  The hitboxes
+ * @param base:   Index of the first hitbox in the block
+ * @param hits:   A bit per hitbox in the block, set if it overlaps
+ * @param result: The result to add to
+ */
+static void collect(const ObjectRange& range, int base, uint32_t hits, OverlapResult& result)
+{
+  for (; hits; hits &= hits - 1)
+  {
+    int i = base + getLowestBit(hits);
+    result.hits++;
+
+    // Hitboxes are tested in order, so the first deadly one found is the first in the run
+    if (range.flags[i] & COLLIDE_DEADLY)
+    {
+      if (result.firstDeadly < 0)
+        result.firstDeadly = i;
+    }
+    // The highest top wins, ties go to the first in the run
+    else if (range.flags[i] & COLLIDE_SOLID)
+    {
+      float top = range.y[i] - range.halfHeight[i];
+      if (result.bestLanding < 0 or top < result.landingTop)
+      {
+        result.bestLanding = i;
+        result.landingTop = top;
+      }
+    }
+  }
+}
+
+/**
+ * Tests a box against some of a run one hitbox at a time
+ *
+ * @param box:    The box
+ * @param range:  The hitboxes
+ * @param begin:  Index of the first hitbox to test, the vector kernels finish their runs here
+ * @param mask:   The hit mask, already cleared
+ * @param result: The result to add to
+ */
+static void overlapScalar(const Box& box, const ObjectRange& range, int begin, uint32_t* mask, OverlapResult& result)
+{
+  for (int i = begin; i < range.size; ++i)
+  {
+    // Rounded to float at each step, the same as the vector kernels
+    float xDiff = std::abs(static_cast<float>(box.x - range.x[i]));
+    float yDiff = std::abs(static_cast<float>(box.y - range.y[i]));
+    float xReach = box.halfWidth + range.halfWidth[i];
+    float yReach = box.halfHeight + range.halfHeight[i];
+    if (xDiff < xReach and yDiff < yReach)
+    {
+      mask[i / 32] |= 1u << (i % 32);
+      collect(range, i, 1, result);
+    }
+  }
+}
+
+#ifdef OVERLAP_VECTOR
+/**
+ * Tests a box against a run four hitboxes at a time
+ *
+ * @param box:    The box
+ * @param range:  The hitboxes
+ * @param mask:   The hit mask, already cleared
+ * @param result: The result to add to
+ */
+VECTOR_TARGET("sse2")
+static void overlapSse2(const Box& box, const ObjectRange& range, uint32_t* mask, OverlapResult& result)
+{
+  // Clearing the sign bit takes the absolute value
+  const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  const __m128 boxX = _mm_set1_ps(box.x);
+  const __m128 boxY = _mm_set1_ps(box.y);
+  const __m128 boxHalfWidth = _mm_set1_ps(box.halfWidth);
+  const __m128 boxHalfHeight = _mm_set1_ps(box.halfHeight);
+
+  int i = 0;
+  for (; i + 4 <= range.size; i += 4)
+  {
+    __m128 xDiff = _mm_and_ps(_mm_sub_ps(boxX, _mm_loadu_ps(range.x + i)), absMask);
+    __m128 yDiff = _mm_and_ps(_mm_sub_ps(boxY, _mm_loadu_ps(range.y + i)), absMask);
+    __m128 xReach = _mm_add_ps(boxHalfWidth, _mm_loadu_ps(range.halfWidth + i));
+    __m128 yReach = _mm_add_ps(boxHalfHeight, _mm_loadu_ps(range.halfHeight + i));
+    uint32_t hits = _mm_movemask_ps(_mm_and_ps(_mm_cmplt_ps(xDiff, xReach), _mm_cmplt_ps(yDiff, yReach)));
+    if (hits)
+    {
+      mask[i / 32] |= hits << (i % 32);
+      collect(range, i, hits, result);
+    }
+  }
+
+  overlapScalar(box, range, i, mask, result);
+}
+
+/**
+ * Tests a box against a run eight hitboxes at a time
+ *
+ * @param box:    The box
+ * @param range:  The hitboxes
+ * @param mask:   The hit mask, already cleared
+ * @param result: The result to add to
+ */
+VECTOR_TARGET("avx2")
+static void overlapAvx2(const Box& box, const ObjectRange& range, uint32_t* mask, OverlapResult& result)
+{
+  const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  const __m256 boxX = _mm256_set1_ps(box.x);
+  const __m256 boxY = _mm256_set1_ps(box.y);
+  const __m256 boxHalfWidth = _mm256_set1_ps(box.halfWidth);
+  const __m256 boxHalfHeight = _mm256_set1_ps(box.halfHeight);
+
+  int i = 0;
+  for (; i + 8 <= range.size; i += 8)
+  {
+    __m256 xDiff = _mm256_and_ps(_mm256_sub_ps(boxX, _mm256_loadu_ps(range.x + i)), absMask);
+    __m256 yDiff = _mm256_and_ps(_mm256_sub_ps(boxY, _mm256_loadu_ps(range.y + i)), absMask);
+    __m256 xReach = _mm256_add_ps(boxHalfWidth, _mm256_loadu_ps(range.halfWidth + i));
+    __m256 yReach = _mm256_add_ps(boxHalfHeight, _mm256_loadu_ps(range.halfHeight + i));
+    __m256 overlap = _mm256_and_ps(_mm256_cmp_ps(xDiff, xReach, _CMP_LT_OQ), _mm256_cmp_ps(yDiff, yReach, _CMP_LT_OQ));
+    uint32_t hits = _mm256_movemask_ps(overlap);
+    if (hits)
+    {
+      mask[i / 32] |= hits << (i % 32);
+      collect(range, i, hits, result);
+    }
+  }
+
+  // Clear the upper halves before the scalar tail, mixing the two without it stalls
+  _mm256_zeroupper();
+  overlapScalar(box, range, i, mask, result);
+}
+
+/**
+ * Checks which vector kernels the CPU and OS support
+ *
+ * @returns The fastest supported kernel
+ */
+static OverlapKernel detectKernel()
+{
+  unsigned int regs[4] = {}; // eax, ebx, ecx and edx
+#ifdef OVERLAP_MSVC
+  int info[4];
+  __cpuid(info, 0);
+  int maxLeaf = info[0];
+  __cpuid(info, 1);
+  for (int i = 0; i < 4; ++i)
+    regs[i] = info[i];
+#else
+  int maxLeaf = __get_cpuid_max(0, nullptr);
+  if (not __get_cpuid(1, &regs[0], &regs[1], &regs[2], &regs[3]))
+    return OVERLAP_SCALAR;
+#endif
+
+  bool sse2 = regs[3] & (1u << 26);
+  bool avx = (regs[2] & (1u << 27)) and (regs[2] & (1u << 28)); // OSXSAVE and AVX
+  if (not sse2)
+    return OVERLAP_SCALAR;
+  if (not avx or maxLeaf < 7)
+    return OVERLAP_SSE2;
+
+  // The OS has to save the AVX registers on a context switch as well
+  uint32_t xcr0;
+#ifdef OVERLAP_MSVC
+  xcr0 = static_cast<uint32_t>(_xgetbv(0));
+#else
+  uint32_t xcr0High;
+  __asm__("xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0));
+#endif
+  if ((xcr0 & 6) != 6)
+    return OVERLAP_SSE2;
+
+#ifdef OVERLAP_MSVC
+  __cpuidex(info, 7, 0);
+  regs[1] = info[1];
+#else
+  __cpuid_count(7, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+  bool avx2 = regs[1] & (1u << 5);
+  return avx2 ? OVERLAP_AVX2 : OVERLAP_SSE2;
+}
+#endif
+
+/**
+ * Gets the fastest kernel this CPU supports, checked once
+ *
+ * @returns The kernel
+ */
+OverlapKernel getOverlapKernel()
+{
+#ifdef OVERLAP_VECTOR
+  static const OverlapKernel kernel = detectKernel();
+  return kernel;
+#else
+  return OVERLAP_SCALAR;
+#endif
+}
+
+/**
+ * Gets the name of a kernel
+ *
+ * @param kernel: The kernel
+ *
+ * @returns The name
+ */
+const char* getOverlapKernelName(OverlapKernel kernel)
+{
+  switch (kernel)
+  {
+  case OVERLAP_SSE2:
+    return "SSE2";
+  case OVERLAP_AVX2:
+    return "AVX2";
+  default:
+    return "scalar";
+  }
+}
+
+/**
+ * Tests a box against every hitbox in a run, with the fastest kernel
+ *
+ * @param box:   The box
+ * @param range: The hitboxes
+ * @param mask:  Filled with a bit per hitbox, set if it overlaps, getOverlapMaskWords() long
+ *
+ * @returns What overlapped
+ */
+OverlapResult overlapBoxes(const Box& box, const ObjectRange& range, uint32_t* mask)
+{
+  return overlapBoxes(box, range, mask, getOverlapKernel());
+}
+
+/**
+ * Tests a box against every hitbox in a run, with a chosen kernel
+ * Kernels the CPU doesn't support fall back to the fastest one it does
+ *
+ * @param box:    The box
+ * @param range:  The hitboxes
+ * @param mask:   Filled with a bit per hitbox, set if it overlaps, getOverlapMaskWords() long
+ * @param kernel: The kernel to use
+ *
+ * @returns What overlapped
+ */
+OverlapResult overlapBoxes(const Box& box, const ObjectRange& range, uint32_t* mask, OverlapKernel kernel)
+{
+  OverlapResult result = {0, -1, -1, 0.0f};
+  std::memset(mask, 0, getOverlapMaskWords(range.size) * sizeof(uint32_t));
+
+  if (kernel > getOverlapKernel())
+    kernel = getOverlapKernel();
+
+#ifdef OVERLAP_VECTOR
+  if (kernel == OVERLAP_AVX2)
+  {
+    overlapAvx2(box, range, mask, result);
+    return result;
+  }
+  if (kernel == OVERLAP_SSE2)
+  {
+    overlapSse2(box, range, mask, result);
+    return result;
+  }
+#endif
+
+  overlapScalar(box, range, 0, mask, result);
+  return result;
+}
@@ -0,0 +1,126 @@
+#ifndef OVERLAP_H
+#define OVERLAP_H
+
+#include <cstdint> // For uint8_t and uint32_t
+
+// Flags describing how an object collides
+const uint8_t COLLIDE_DEADLY = 1 << 0;   // Kills the player on contact
+const uint8_t COLLIDE_SOLID = 1 << 1;    // Can be landed on
+const uint8_t COLLIDE_PLATFORM = 1 << 2; // A half height platform
+
+// A contiguous run of hitboxes, stored as a structure of arrays
+struct ObjectRange
+{
+  const float* x;          // Centre x of each hitbox, in pixels
+  const float* y;          // Centre y of each hitbox, in pixels
+  const float* halfWidth;  // Half the width of each hitbox, in pixels
+  const float* halfHeight; // Half the height of each hitbox, in pixels
+  const uint8_t* flags;    // The COLLIDE_ flags of each object
+  int size;                // How many objects are in the run
+};
+
+// A hitbox to test against a run of hitboxes
+struct Box
+{
+  float x;          // Centre x, in pixels
+  float y;          // Centre y, in pixels
+  float halfWidth;  // Half the width, in pixels
+  float halfHeight; // Half the height, in pixels
+};
+
+// What testing a Box against a run found
+struct OverlapResult
+{
+  int hits;         // How many hitboxes overlap the box
+  int firstDeadly;  // Index of the first overlapping deadly hitbox, or -1
+  int bestLanding;  // Index of the overlapping solid hitbox with the highest top, or -1
+  float landingTop; // The top of that hitbox, in pixels
+};
+
+// The ways of testing a run, from slowest to fastest
+enum OverlapKernel
+{
+  OVERLAP_SCALAR, // One hitbox at a time, works everywhere
+  OVERLAP_SSE2,   // Four hitboxes at a time
+  OVERLAP_AVX2    // Eight hitboxes at a time
+};
+
+// Boxes overlap when their centres are closer than the sum of their half sizes on both axes,
+// so boxes that only touch don't overlap
+// Every kernel gives exactly the same results, the vector ones are only faster
+
+/**
+ * Gets the fastest kernel this CPU supports, checked once
+ *
+ * @returns The kernel
+ */
+OverlapKernel getOverlapKernel();
+
+/**
+ * Gets the name of a kernel
+ *
+ * @param kernel: The kernel
+ *
+ * @returns The name
+ */
+const char* getOverlapKernelName(OverlapKernel kernel);
+
+/**
+ * Gets how many words the hit mask of a run needs
+ *
+ * @param size: The number of hitboxes in the run
+ *
+ * @returns The number of words
+ */
+inline int getOverlapMaskWords(int size)
+{
+  return (size + 31) / 32;
+}
+
+/**
+ * Tests a box against every hitbox in a run, with the fastest kernel
+ *
+ * @param box:   The box
+ * @param range: The hitboxes
+ * @param mask:  Filled with a bit per hitbox, set if it overlaps, getOverlapMaskWords() long
+ *
+ * @returns What overlapped
+ */
+OverlapResult overlapBoxes(const Box& box, const ObjectRange& range, uint32_t* mask);
+
+/**
+ * Tests a box against every hitbox in a run, with a chosen kernel
+ * Kernels the CPU doesn't support fall back to the fastest one it does
+ *
+ * @param box:    The box
+ * @param range:  The hitboxes
+ * @param mask:   Filled with a bit per hitbox, set if it overlaps, getOverlapMaskWords() long
+ * @param kernel: The kernel to use
+ *
+ * @returns What overlapped
+ */
+OverlapResult overlapBoxes(const Box& box, const ObjectRange& range, uint32_t* mask, OverlapKernel kernel);
+
+/**
+ * Finds the lowest set bit of a mask word
+ *
+ * @param bits: The word, must not be 0
+ *
+ * @returns The index of the bit
+ */
+inline int getLowestBit(uint32_t bits)
+{
+#if defined(__GNUC__)
+  return __builtin_ctz(bits);
+#else
+  int index = 0;
+  while (not (bits & 1))
+  {
+    bits >>= 1;
+    index++;
+  }
+  return index;
+#endif
+}
+
+#endif //! OVERLAP_H
@@ -7,9 +7,19 @@
  */
 Platform::Platform(const Vertex& pos) :
   Block(pos, PIXELS_PER_BLOCK, PIXELS_PER_BLOCK / 2, PLATFORM_FILE_NAME)
+{
+  place(pos);
+}
+
+/**
+ * Moves the platform, used when it is reused from a pool
+ *
+ * @param pos: The new position of the object in the level
+ */
+void Platform::place(const Vertex& pos)
 {
   // Shift the platform a quarter block up
   // This way it will be in the top half of the square
   // Make sure it lines up with full blocks next to it
-  _image.setY(pos.second - PIXELS_PER_BLOCK / 4);
+  Object::place(Vertex(pos.first, pos.second - PIXELS_PER_BLOCK / 4));
 }
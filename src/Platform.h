@@ -12,6 +12,13 @@ public:
    * @param pos: The position of the object on the screen
    */
   Platform(const Vertex& pos);
+
+  /**
+   * Moves the platform, used when it is reused from a pool
+   *
+   * @param pos: The new position of the object in the level
+   */
+  void place(const Vertex& pos) override;
 };
 
 #endif //! PLATFORM_H
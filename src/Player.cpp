@@ -1,117 +1,312 @@
 #include "Player.h"
-#include "Array.h"
 #include "Constants.h"
+#include <algorithm> // For std::max and std::min
+#include <cmath>     // For std::abs
+#include <limits>    // For std::numeric_limits
+
+// How many objects are tested against the player at once, so the hit mask fits on the stack
+const int OVERLAP_CHUNK = 256;
+
+// The overlap test is done in float, so the boxes handed to it are padded by this much,
+// so that rounding can't drop an object the exact test would have hit, in pixels
+const float OVERLAP_PADDING = 1.0f;
+
+// How close the bottom of the player has to be to the top of an object to count as resting on it, in pixels
+const double SURFACE_TOLERANCE = 0.001;
+
+/**
+ * Finds when a moving point is closer than some distance to a fixed one, along one axis
+ *
+ * @param start:  Where the point starts
+ * @param move:   How far the point moves over the step
+ * @param centre: The fixed point
+ * @param reach:  How close the point has to be
+ * @param enter:  Set to when it gets that close, as a fraction of the step
+ * @param exit:   Set to when it stops being that close, as a fraction of the step
+ *
+ * @returns False if it is never that close
+ */
+static bool getOverlapTimes(double start, double move, double centre, double reach, double& enter, double& exit)
+{
+  // Not moving, so either always close or never
+  if (move == 0.0)
+  {
+    enter = -std::numeric_limits<double>::infinity();
+    exit = std::numeric_limits<double>::infinity();
+    return std::abs(start - centre) < reach;
+  }
+
+  double first = (centre - reach - start) / move;
+  double second = (centre + reach - start) / move;
+  enter = std::min(first, second);
+  exit = std::max(first, second);
+  return true;
+}
+
+/**
+ * Calls a function for every object in some runs that overlaps a box
+ *
+ * @param box:        The box
+ * @param ranges:     The runs of objects
+ * @param rangeCount: How many runs there are
+ * @param visit:      Called with the run and the index of each overlapping object, in order
+ */
+template <typename Visit>
+static void forEachOverlap(const Box& box, const ObjectRange* ranges, int rangeCount, Visit visit)
+{
+  uint32_t mask[OVERLAP_CHUNK / 32];
+  for (int r = 0; r < rangeCount; ++r)
+  {
+    for (int begin = 0; begin < ranges[r].size; begin += OVERLAP_CHUNK)
+    {
+      ObjectRange chunk = ranges[r];
+      chunk.x += begin;
+      chunk.y += begin;
+      chunk.halfWidth += begin;
+      chunk.halfHeight += begin;
+      chunk.flags += begin;
+      chunk.size = std::min(ranges[r].size - begin, OVERLAP_CHUNK);
+
+      if (overlapBoxes(box, chunk, mask).hits == 0)
+        continue;
+
+      for (int word = 0; word < getOverlapMaskWords(chunk.size); ++word)
+        for (uint32_t bits = mask[word]; bits; bits &= bits - 1)
+          visit(chunk, word * 32 + getLowestBit(bits));
+    }
+  }
+}
 
 // Default Constructor
 Player::Player() :
   Object(PLAYER_STARTING_POS, PIXELS_PER_BLOCK, PIXELS_PER_BLOCK, PLAYER_IMAGE_FILE)
 {
+  reset();
 }
 
 /**
- * Updates the player
+ * Moves the player on by one step
+ * Collisions are swept from where they were last checked, so a long step can't skip past an object
+ *
+ * @param objects:    The objects in the game, only the ones near the player are checked
+ * @param cameraX:    The x of the left side of the screen, in the objects' coordinates
+ * @param scroll:     How far the camera moved since the last step, in pixels
+ * @param stepLength: The length of the step, in seconds
  *
- * @param elapsed: How much time since the last update call, in seconds
- * @param objects: The array of objects in the game
+ * @returns True if the player died
  */
-bool Player::update(double elapsed, const Array<Object*>& objects)
+bool Player::step(const ObjectStore& objects, double cameraX, double scroll, double stepLength)
 {
   // Reset their ground state
   _onGround = false;
+  _previousY = _pos.second;
 
-  // Get the position of the player
-  double x = _image.getX();
-  double y = _image.getY();
+  // Where the player is now, and where collisions were last checked, in the objects' coordinates
+  double x = _pos.first + cameraX;
+  double y = _pos.second;
+  double startX = x - scroll;
+  double startY = _checkedY;
 
-  // Loop through each object and check for collisions
-  for (auto i : objects)
-  {
-    // Find the distance between the object and the player
-    double xDiff = x - i->getX();
-    double yDiff = y - i->getY();
+  // The hitboxes of the objects in the cells the player swept through, in at most two contiguous runs
+  ObjectRange ranges[2];
+  int rangeCount = objects.getRanges(startX - _width / 2, x + _width / 2, ranges);
 
-    // Check if the distance is less than half of the dimensions
-    bool xCollide = (abs(xDiff) < (_width / 2 + i->getWidth() / 2));
-    bool yCollide = (abs(yDiff) < (_height / 2 + i->getHeight() / 2));
+  // The move is swept as a whole, each object is hit when the player first overlaps it on
+  // both axes, and the axis that overlapped last says whether it was hit from above,
+  // below or the side
+  // Landing ends the fall, so the rest of the move is then swept forward at that height
+  double moveX = x - startX;
+  double moveY = y - startY;
 
-    // Since all blocks are the same size, objects will always collide on both axis
-    if (xCollide and yCollide)
-    {
-      // Hit head
-      if (yDiff > 0)
-      {
-        return true;
-      }
+  // The first surface the player reached, and the first thing that killed it
+  bool landed = false;
+  double landTime = 0.0;
+  double landY = 0.0;
+  bool died = false;
+  double deathTime = 0.0;
 
-      // Calculate the destination after moving player out of block
+  // Only the objects touching the box swept out by the player can be hit
+  Box swept;
+  swept.x = static_cast<float>((startX + x) / 2);
+  swept.y = static_cast<float>((startY + y) / 2);
+  swept.halfWidth = static_cast<float>((moveX + _width) / 2) + OVERLAP_PADDING;
+  swept.halfHeight = static_cast<float>((std::abs(moveY) + _height) / 2) + OVERLAP_PADDING;
 
-      double xDest = i->getX() - (_width / 2 + i->getWidth() / 2);
-      double yDest = i->getY() - (_height / 2 + i->getHeight() / 2);
+  forEachOverlap(swept, ranges, rangeCount, [&](const ObjectRange& range, int i) {
+    // How close the centres can get before the player and the object overlap
+    double reachX = _width / 2 + range.halfWidth[i];
+    double reachY = _height / 2 + range.halfHeight[i];
+    double top = range.y[i] - reachY;
 
-      // Find the distance they need to move to their new position
+    // Objects the player was already inside (e.g. one that spawned on it) can't be swept,
+    // so check them where the player is now, the same way as without sweeping
+    if (std::abs(startX - range.x[i]) < reachX and std::abs(startY - range.y[i]) < reachY)
+    {
+      double xDiff = x - range.x[i];
+      double yDiff = y - range.y[i];
+      if (std::abs(xDiff) >= reachX or std::abs(yDiff) >= reachY)
+        return;
 
-      double xToMove = abs(xDest - x);
-      double yToMove = abs(yDest - y);
+      // Calculate the destination after moving player out of block
+      double xDest = range.x[i] - reachX;
 
-      // Hit spike
-      if (i->isDeadly())
-      {
-        return true;
-      }
-      // Hit wall
-      if (xToMove < yToMove)
+      // Hit head, spike or wall
+      if (yDiff > 0 or (range.flags[i] & COLLIDE_DEADLY) or std::abs(xDest - x) < std::abs(top - y))
       {
-        return true;
+        died = true;
+        deathTime = 0.0;
       }
       // Landed on block
-      else
+      else if (not landed or landTime > 0.0 or top < landY)
       {
-        _onGround = true;
+        landed = true;
+        landTime = 0.0;
+        landY = top;
+      }
+      return;
+    }
+
+    // When the player overlaps the object on each axis, then on both
+    double enterX, exitX, enterY, exitY;
+    if (not getOverlapTimes(startX, moveX, range.x[i], reachX, enterX, exitX) or
+        not getOverlapTimes(startY, moveY, range.y[i], reachY, enterY, exitY))
+      return;
+
+    double enter = std::max(enterX, enterY);
+    double exit = std::min(exitX, exitY);
+    if (enter >= exit or enter >= 1.0 or exit <= 0.0)
+      return;
 
-        // Move to new position
-        _image.setY(yDest);
+    // A player resting level with the top of the object slides onto it, gravity sinking
+    // it a little doesn't make the side of the next block a wall
+    bool resting = moveY > 0 and std::abs(startY - top) < SURFACE_TOLERANCE;
 
-        // Stop moving
-        _velocity = 0.0;
+    // Fell onto the top of the object, a spike kills
+    if ((enterY > enterX or resting) and moveY > 0 and not (range.flags[i] & COLLIDE_DEADLY))
+    {
+      // The first surface reached wins, then the highest
+      if (not landed or enter < landTime or (enter == landTime and top < landY))
+      {
+        landed = true;
+        landTime = enter;
+        landY = top;
       }
     }
+    // Hit head, spike or wall
+    else if (not died or enter < deathTime)
+    {
+      died = true;
+      deathTime = enter;
+    }
+  });
+
+  // Dying only counts if it happened before the player landed
+  if (died and (not landed or deathTime <= landTime))
+    return true;
+
+  if (landed)
+  {
+    _onGround = true;
+
+    // Move to new position
+    _pos.second = landY;
+
+    // Stop moving
+    _velocity = 0.0;
+
+    // Then sweep the rest of the move forward at the new height, anything the front of
+    // the player runs into kills it
+    double landX = startX + moveX * landTime;
+    Box forward;
+    forward.x = swept.x;
+    forward.y = static_cast<float>(landY);
+    forward.halfWidth = swept.halfWidth;
+    forward.halfHeight = static_cast<float>(_height / 2) + OVERLAP_PADDING;
+
+    bool hitWall = false;
+    forEachOverlap(forward, ranges, rangeCount, [&](const ObjectRange& range, int i) {
+      double reachX = _width / 2 + range.halfWidth[i];
+      double reachY = _height / 2 + range.halfHeight[i];
+
+      // Hit wall or spike
+      double left = range.x[i] - reachX;
+      if (std::abs(landY - range.y[i]) < reachY and landX <= left and x > left)
+        hitWall = true;
+    });
+    if (hitWall)
+      return true;
   }
 
+  // The next step sweeps from here
+  _checkedY = _pos.second;
+
   // Jump if on block and jump in buffer
-  if (_jumpFrames and _onGround)
+  if (_jumpSteps and _onGround)
   {
     // Reset buffer
-    _jumpFrames = 0;
+    _jumpSteps = 0;
 
     // Set jump velocity
     _velocity = JUMP_VELOCITY_PIXELS;
 
     // Update position based on velocity
-    _image.setY(_image.getY() + _velocity * elapsed);
+    _pos.second += _velocity * stepLength;
 
-    // Return to avoid applying gravity on the same frame as a jump
+    // Return to avoid applying gravity on the same step as a jump
     return false; // Player didn't die
   }
 
   // Apply gravity
-  _velocity += GRAVITY_PIXELS * elapsed;
+  _velocity += GRAVITY_PIXELS * stepLength;
 
   // Update position based on velocity
-  _image.setY(_image.getY() + _velocity * elapsed);
+  _pos.second += _velocity * stepLength;
 
   // If they didn't jump, decrement the buffer size
-  if (_jumpFrames)
-    _jumpFrames--;
+  if (_jumpSteps)
+    _jumpSteps--;
 
   // Check if the player fell off of the screen
-  bool offScreen = (_image.getY() - _height / 2) > WINDOW_HEIGHT;
+  bool offScreen = (_pos.second - _height / 2) > WINDOW_HEIGHT;
   return offScreen;
 }
 
 /**
  * Queues a jump
+ *
+ * @param steps: How many steps the jump stays queued for
  */
-void Player::jump()
+void Player::jump(int steps)
 {
-  _jumpFrames = JUMP_FRAMES;
+  _jumpSteps = steps;
+}
+
+/**
+ * Puts the player back at the start, for a new attempt
+ */
+void Player::reset()
+{
+  _velocity = 0.0;
+  _jumpSteps = 0;
+  _onGround = false;
+
+  _pos = PLAYER_STARTING_POS;
+  _previousY = _pos.second;
+  _checkedY = _pos.second;
+}
+
+/**
+ * Moves the player to a height, moving vertically, as if it got there on its own
+ *
+ * @param y:        The y position
+ * @param velocity: The y velocity, in pixels per second
+ */
+void Player::setMotion(double y, double velocity)
+{
+  _velocity = velocity;
+  _onGround = false;
+
+  _pos.second = y;
+  _previousY = y;
+  _checkedY = y;
 }
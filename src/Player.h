@@ -1,32 +1,69 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 
-#include "Array.h"  // For Array class
-#include "Object.h" // For Object class
+#include "Object.h"      // For Object class
+#include "ObjectStore.h" // For ObjectStore class
 
 // Represents a player in a Level
+//
+// The player stays still on the screen, so its position is in screen coordinates
+// It has no sprite of its own, the Level draws it between steps
 class Player : public Object
 {
-  double _velocity = 0.0; // Current y velocity, in pixels per second
-  int _jumpFrames = 0;    // Current frames left in the jump buffer
-  bool _onGround = false; // Is the Player on the ground
+  double _previousY = 0.0; // The y before the last step, for drawing between steps
+  double _checkedY = 0.0;  // The y collisions were last checked at, the next step sweeps from there
+  double _velocity = 0.0;  // Current y velocity, in pixels per second
+  int _jumpSteps = 0;      // Current steps left in the jump buffer
+  bool _onGround = false;  // Is the Player on the ground
 
 public:
   // Default Constructor
   Player();
 
   /**
-   * Updates the player
+   * Moves the player on by one step
+   * Collisions are swept from where they were last checked, so a long step can't skip past an object
    *
-   * @param elapsed: How much time since the last update call, in seconds
-   * @param objects: The array of objects in the game
+   * @param objects:    The objects in the game, only the ones near the player are checked
+   * @param cameraX:    The x of the left side of the screen, in the objects' coordinates
+   * @param scroll:     How far the camera moved since the last step, in pixels
+   * @param stepLength: The length of the step, in seconds
+   *
+   * @returns True if the player died
    */
-  bool update(double elapsed, const Array<Object*>& objects) override;
+  bool step(const ObjectStore& objects, double cameraX, double scroll, double stepLength);
+
+  /**
+   * Gets where to draw the player, between the last two steps
+   *
+   * @param alpha: How far through the step, from 0 (the previous step) to 1 (the last step)
+   *
+   * @returns The y position
+   */
+  double getRenderY(double alpha) const
+  {
+    return _previousY + (_pos.second - _previousY) * alpha;
+  }
 
   /**
    * Queues a jump
+   *
+   * @param steps: How many steps the jump stays queued for
+   */
+  void jump(int steps);
+
+  /**
+   * Puts the player back at the start, for a new attempt
+   */
+  void reset();
+
+  /**
+   * Moves the player to a height, moving vertically, as if it got there on its own
+   *
+   * @param y:        The y position
+   * @param velocity: The y velocity, in pixels per second
    */
-  void jump();
+  void setMotion(double y, double velocity);
 };
 
 #endif //! PLAYER_H
@@ -0,0 +1,304 @@
+#include "Replay.h"
+#include "MappedFile.h" // For MappedFile class
+#include <cstring>      // For memcpy
+#include <fstream>      // For ofstream
+#include <iostream>     // For std::cout
+
+// FNV-1a parameters for 64 bit hashes
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+const uint64_t FNV_PRIME = 1099511628211ull;
+
+/**
+ * Adds some bytes to an FNV-1a hash
+ *
+ * @param hash:  The hash so far
+ * @param value: The value to add, low byte first
+ * @param bytes: How many bytes of the value to add
+ *
+ * @returns The new hash
+ */
+static uint64_t hashBytes(uint64_t hash, uint64_t value, int bytes)
+{
+  for (int i = 0; i < bytes; ++i)
+    hash = (hash ^ ((value >> (8 * i)) & 0xff)) * FNV_PRIME;
+  return hash;
+}
+
+/**
+ * Hashes the layout of a level, the same however the level is stored
+ *
+ * @param data: The level
+ *
+ * @returns The 64 bit FNV-1a hash of the columns
+ */
+uint64_t hashLayout(const LevelData& data)
+{
+  uint64_t hash = hashBytes(FNV_OFFSET_BASIS, data.getColumnCount(), 4);
+
+  LevelCursor cursor(data, 0);
+  while (not cursor.atEnd())
+  {
+    Column column = cursor.next();
+    hash = hashBytes(hash, column.end() - column.begin(), 2);
+    for (const Spawn& spawn : column)
+    {
+      hash = hashBytes(hash, spawn.type, 1);
+      hash = hashBytes(hash, spawn.y, 1);
+    }
+  }
+
+  return hash;
+}
+
+/**
+ * Writes a value as a varint
+ *
+ * @param bytes: Where to write
+ * @param value: The value
+ */
+static void writeVarint(std::string& bytes, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    bytes += static_cast<char>((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  bytes += static_cast<char>(value);
+}
+
+/**
+ * Writes a fixed size little endian value
+ *
+ * @param bytes: Where to write
+ * @param value: The value
+ * @param size:  How many bytes to write
+ */
+static void writeFixed(std::string& bytes, uint64_t value, int size)
+{
+  for (int i = 0; i < size; ++i)
+    bytes += static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+/**
+ * Reads a varint, checking it fits in the data
+ *
+ * @param next:  The next byte to read, moved past the varint
+ * @param end:   The end of the data
+ * @param value: Set to the value
+ *
+ * @returns False if the varint runs off the end or is too long
+ */
+static bool readVarint(const uint8_t*& next, const uint8_t* end, uint64_t& value)
+{
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7)
+  {
+    if (next == end)
+      return false;
+
+    uint8_t byte = *next++;
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (not (byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+/**
+ * Reads a fixed size little endian value, checking it fits in the data
+ *
+ * @param next:  The next byte to read, moved past the value
+ * @param end:   The end of the data
+ * @param size:  How many bytes to read
+ * @param value: Set to the value
+ *
+ * @returns False if the value runs off the end
+ */
+static bool readFixed(const uint8_t*& next, const uint8_t* end, int size, uint64_t& value)
+{
+  if (end - next < size)
+    return false;
+
+  value = 0;
+  for (int i = 0; i < size; ++i)
+    value |= static_cast<uint64_t>(*next++) << (8 * i);
+  return true;
+}
+
+/**
+ * Starts recording a new attempt, forgetting the last one
+ *
+ * @param levelHash:   hashLayout() of the level
+ * @param stepLength:  The length of each step, in seconds
+ * @param startColumn: The column the attempt starts from
+ */
+void Replay::start(uint64_t levelHash, double stepLength, int startColumn)
+{
+  _levelHash = levelHash;
+  _stepLength = stepLength;
+  _startColumn = startColumn;
+  _transitions.clear();
+  _jumping = false;
+  _result = STEP_RUNNING;
+  _endStep = 0;
+}
+
+/**
+ * Records jump being pressed or released, anything that isn't a change is ignored
+ *
+ * @param step:    How many steps have run
+ * @param jumping: True if jump is held
+ */
+void Replay::record(int step, bool jumping)
+{
+  // Holding jump queues a jump every step anyway, so repeats of a press change nothing
+  if (jumping == _jumping)
+    return;
+
+  _jumping = jumping;
+  _transitions.pushBack(step);
+}
+
+/**
+ * Records how the attempt ended
+ *
+ * @param result: What happened on the last step
+ * @param step:   How many steps ran
+ */
+void Replay::finish(StepResult result, int step)
+{
+  _result = result;
+  _endStep = step;
+}
+
+/**
+ * Writes the replay to a file
+ *
+ * @param path: The file to write
+ *
+ * @returns True if it was written
+ */
+bool Replay::save(const std::string& path) const
+{
+  uint64_t stepBits;
+  memcpy(&stepBits, &_stepLength, sizeof(stepBits));
+
+  std::string bytes;
+  writeFixed(bytes, REPLAY_MAGIC, 4);
+  writeFixed(bytes, REPLAY_VERSION, 4);
+  writeFixed(bytes, _levelHash, 8);
+  writeFixed(bytes, stepBits, 8);
+  writeVarint(bytes, _startColumn);
+  writeFixed(bytes, _result, 1);
+  writeVarint(bytes, _endStep);
+
+  // Transitions are stored as the steps between them, which are nearly always a byte
+  writeVarint(bytes, _transitions.getSize());
+  uint32_t last = 0;
+  for (int i = 0; i < _transitions.getSize(); ++i)
+  {
+    writeVarint(bytes, _transitions[i] - last);
+    last = _transitions[i];
+  }
+
+  std::ofstream outFile(path, std::ios::binary);
+  if (not outFile)
+  {
+    std::cout << "Could not open " << path << " for writing\n";
+    return false;
+  }
+
+  outFile.write(bytes.data(), bytes.size());
+  return static_cast<bool>(outFile);
+}
+
+/**
+ * Reads a replay from a file
+ *
+ * @param path: The file to read
+ *
+ * @returns True if it was read
+ */
+bool Replay::load(const std::string& path)
+{
+  MappedFile file;
+  if (not file.open(path))
+  {
+    std::cout << "Could not open " << path << "\n";
+    return false;
+  }
+
+  const uint8_t* next = reinterpret_cast<const uint8_t*>(file.getData());
+  const uint8_t* end = next + file.getSize();
+
+  // Check the header before trusting anything after it
+  uint64_t magic, version, levelHash, stepBits, startColumn, result, endStep, count;
+  if (not readFixed(next, end, 4, magic) or not readFixed(next, end, 4, version) or magic != REPLAY_MAGIC or
+      version != REPLAY_VERSION)
+  {
+    std::cout << path << " is not a replay\n";
+    return false;
+  }
+
+  if (not readFixed(next, end, 8, levelHash) or not readFixed(next, end, 8, stepBits) or
+      not readVarint(next, end, startColumn) or not readFixed(next, end, 1, result) or
+      not readVarint(next, end, endStep) or not readVarint(next, end, count) or result > STEP_FINISHED or
+      startColumn > INT32_MAX or endStep > INT32_MAX or count > static_cast<uint64_t>(end - next))
+  {
+    std::cout << path << " is corrupt\n";
+    return false;
+  }
+
+  double stepLength;
+  memcpy(&stepLength, &stepBits, sizeof(stepLength));
+  start(levelHash, stepLength, static_cast<int>(startColumn));
+
+  // Turn the deltas back into steps, which never go past the end
+  uint64_t step = 0;
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    uint64_t delta;
+    if (not readVarint(next, end, delta) or delta > endStep - step)
+    {
+      std::cout << path << " is corrupt\n";
+      return false;
+    }
+
+    step += delta;
+    record(static_cast<int>(step), not _jumping);
+  }
+
+  finish(static_cast<StepResult>(result), static_cast<int>(endStep));
+  return true;
+}
+
+/**
+ * Replays the inputs from the start of an attempt, stopping on the recorded end step at the latest
+ *
+ * @param simulation: A simulation of the same layout, step length and start column, it is reset first
+ *
+ * @returns How the replayed attempt ended, check the step it ended on with simulation.getStep()
+ */
+StepResult Replay::play(Simulation& simulation) const
+{
+  simulation.reset();
+
+  int next = 0;
+  bool jumping = false;
+  while (simulation.getStep() < _endStep)
+  {
+    // Every press and release due before this step, in the order they happened
+    while (next < _transitions.getSize() and static_cast<int>(_transitions[next]) == simulation.getStep())
+    {
+      jumping = not jumping;
+      simulation.setJumping(jumping);
+      next++;
+    }
+
+    StepResult result = simulation.step();
+    if (result != STEP_RUNNING)
+      return result;
+  }
+
+  return STEP_RUNNING;
+}
@@ -0,0 +1,173 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "Array.h"      // For Array class
+#include "LevelData.h"  // For LevelData class
+#include "Simulation.h" // For Simulation class and StepResult enum
+#include <cstdint>      // For uint32_t and uint64_t
+#include <string>       // For std::string
+
+// Layout of a replay (.gdr) file
+//
+// Fixed size values are little endian, varints are LEB128 (7 bits a byte, low bits first)
+//
+//   uint32_t magic                   must be REPLAY_MAGIC
+//   uint32_t version                 must be REPLAY_VERSION
+//   uint64_t levelHash               hashLayout() of the level it was recorded on
+//   uint64_t stepLength              bits of the step length as a double, in seconds
+//   varint startColumn               the column the attempt started from
+//   uint8_t result                   the StepResult the attempt ended with
+//   varint endStep                   the step it ended on
+//   varint transitionCount           how many times jump was pressed or released
+//   varint deltas[transitionCount]   steps since the last transition, or since the start
+//
+// The first transition is a press, and they alternate after that
+// A transition at step n happens after n steps have run, before step n + 1
+
+// Extension of replay files
+const char* const REPLAY_EXTENSION = ".gdr";
+
+// Identifies a replay file ("GDRP")
+const uint32_t REPLAY_MAGIC = 0x50524447;
+
+// Bumped whenever the layout, or the physics it replays, changes
+const uint32_t REPLAY_VERSION = 2;
+
+/**
+ * Hashes the layout of a level, the same however the level is stored
+ *
+ * @param data: The level
+ *
+ * @returns The 64 bit FNV-1a hash of the columns
+ */
+uint64_t hashLayout(const LevelData& data);
+
+// The jump inputs of an attempt and how it ended
+//
+// A Simulation is deterministic, so replaying the same inputs on the same layout
+// with the same step length gives the same attempt, down to the step
+class Replay
+{
+  uint64_t _levelHash = 0;              // hashLayout() of the level
+  double _stepLength = SIMULATION_STEP; // The length of each step, in seconds
+  int _startColumn = 0;                 // The column the attempt started from
+  Array<uint32_t> _transitions;         // The step of each press or release, in order
+  bool _jumping = false;                // Is jump held at the end of the recording
+  StepResult _result = STEP_RUNNING;    // How the attempt ended
+  int _endStep = 0;                     // The step the attempt ended on
+
+public:
+  /**
+   * Starts recording a new attempt, forgetting the last one
+   *
+   * @param levelHash:   hashLayout() of the level
+   * @param stepLength:  The length of each step, in seconds
+   * @param startColumn: The column the attempt starts from
+   */
+  void start(uint64_t levelHash, double stepLength, int startColumn);
+
+  /**
+   * Records jump being pressed or released, anything that isn't a change is ignored
+   *
+   * @param step:    How many steps have run
+   * @param jumping: True if jump is held
+   */
+  void record(int step, bool jumping);
+
+  /**
+   * Records how the attempt ended
+   *
+   * @param result: What happened on the last step
+   * @param step:   How many steps ran
+   */
+  void finish(StepResult result, int step);
+
+  /**
+   * Writes the replay to a file
+   *
+   * @param path: The file to write
+   *
+   * @returns True if it was written
+   */
+  bool save(const std::string& path) const;
+
+  /**
+   * Reads a replay from a file
+   *
+   * @param path: The file to read
+   *
+   * @returns True if it was read
+   */
+  bool load(const std::string& path);
+
+  /**
+   * Replays the inputs from the start of an attempt, stopping on the recorded end step at the latest
+   *
+   * @param simulation: A simulation of the same layout, step length and start column, it is reset first
+   *
+   * @returns How the replayed attempt ended, check the step it ended on with simulation.getStep()
+   */
+  StepResult play(Simulation& simulation) const;
+
+  /**
+   * Gets the hash of the level the replay was recorded on
+   *
+   * @returns The hashLayout() of the level
+   */
+  uint64_t getLevelHash() const
+  {
+    return _levelHash;
+  }
+
+  /**
+   * Gets the step length the replay was recorded with
+   *
+   * @returns The step length, in seconds
+   */
+  double getStepLength() const
+  {
+    return _stepLength;
+  }
+
+  /**
+   * Gets the column the attempt started from
+   *
+   * @returns The start column
+   */
+  int getStartColumn() const
+  {
+    return _startColumn;
+  }
+
+  /**
+   * Gets how the attempt ended
+   *
+   * @returns The result of the last step, STEP_RUNNING if it was cut short
+   */
+  StepResult getResult() const
+  {
+    return _result;
+  }
+
+  /**
+   * Gets the step the attempt ended on
+   *
+   * @returns The step count
+   */
+  int getEndStep() const
+  {
+    return _endStep;
+  }
+
+  /**
+   * Gets how many times jump was pressed or released
+   *
+   * @returns The number of transitions
+   */
+  int getTransitionCount() const
+  {
+    return _transitions.getSize();
+  }
+};
+
+#endif //! REPLAY_H
@@ -0,0 +1,184 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include "Allocator.h" // For HeapAllocator
+
+// A growable queue stored in a circular buffer
+//
+// Adding to the back and removing from the front are O(1), nothing is shifted
+// The capacity is always a power of two and only ever grows
+// The items are stored in at most two contiguous parts, see getFirstPart() and getSecondPart()
+// Memory comes from the Allocator, see Allocator.h
+template <typename T, typename Allocator = HeapAllocator>
+class RingBuffer
+{
+  T* _items = nullptr;  // The buffer
+  int _capacity = 0;    // Size of the buffer, a power of two
+  int _head = 0;        // Index in the buffer of the front item
+  int _size = 0;        // How many items are queued
+  Allocator _allocator; // Where the buffer comes from
+
+public:
+  // Default Constructor
+  RingBuffer() = default;
+
+  /**
+   * Parameterized Constructor
+   *
+   * @param allocator: Where the buffer comes from
+   */
+  explicit RingBuffer(const Allocator& allocator) :
+    _allocator(allocator)
+  {
+  }
+
+  // Delete copy constructor
+  RingBuffer(const RingBuffer&) = delete;
+
+  // Delete assignment operator
+  RingBuffer& operator=(const RingBuffer&) = delete;
+
+  // Destructor
+  ~RingBuffer()
+  {
+    _allocator.deallocate(_items, _capacity);
+  }
+
+  /**
+   * Subscript operator, not bounds checked
+   *
+   * @param n: The index from the front, from 0 to getSize() - 1
+   */
+  T& operator[](int n)
+  {
+    return _items[(_head + n) & (_capacity - 1)];
+  }
+
+  /**
+   * Subscript operator, not bounds checked
+   *
+   * @param n: The index from the front, from 0 to getSize() - 1
+   */
+  const T& operator[](int n) const
+  {
+    return _items[(_head + n) & (_capacity - 1)];
+  }
+
+  /**
+   * Gets the number of queued items
+   *
+   * @returns The size of the queue
+   */
+  int getSize() const
+  {
+    return _size;
+  }
+
+  /**
+   * Adds an item to the back, doubling the capacity if it is full
+   *
+   * @param value: The item to add
+   */
+  void pushBack(const T& value)
+  {
+    if (_size == _capacity)
+      grow();
+
+    _items[(_head + _size) & (_capacity - 1)] = value;
+    _size++;
+  }
+
+  /**
+   * Removes items from the front
+   *
+   * @param count: How many items to remove, at most getSize()
+   */
+  void popFront(int count = 1)
+  {
+    if (count > _size)
+      count = _size;
+
+    _head = (_head + count) & (_capacity - 1);
+    _size -= count;
+  }
+
+  /**
+   * Removes every item, keeping the capacity
+   */
+  void clear()
+  {
+    _head = 0;
+    _size = 0;
+  }
+
+  /**
+   * Gets the items from the front up to the end of the buffer
+   *
+   * @param size: Set to the number of items in the part
+   *
+   * @returns The front item
+   */
+  T* getFirstPart(int& size)
+  {
+    size = _capacity - _head < _size ? _capacity - _head : _size;
+    return _items + _head;
+  }
+
+  /**
+   * Gets the items from the front up to the end of the buffer
+   *
+   * @param size: Set to the number of items in the part
+   *
+   * @returns The front item
+   */
+  const T* getFirstPart(int& size) const
+  {
+    size = _capacity - _head < _size ? _capacity - _head : _size;
+    return _items + _head;
+  }
+
+  /**
+   * Gets the items that wrapped around to the start of the buffer
+   *
+   * @param size: Set to the number of items in the part, 0 if nothing wrapped
+   *
+   * @returns The item after the last one in the first part
+   */
+  T* getSecondPart(int& size)
+  {
+    size = _head + _size > _capacity ? _head + _size - _capacity : 0;
+    return _items;
+  }
+
+  /**
+   * Gets the items that wrapped around to the start of the buffer
+   *
+   * @param size: Set to the number of items in the part, 0 if nothing wrapped
+   *
+   * @returns The item after the last one in the first part
+   */
+  const T* getSecondPart(int& size) const
+  {
+    size = _head + _size > _capacity ? _head + _size - _capacity : 0;
+    return _items;
+  }
+
+private:
+  /**
+   * Doubles the capacity, unwrapping the items to the start of the new buffer
+   */
+  void grow()
+  {
+    int capacity = _capacity ? _capacity * 2 : 16;
+    T* items = _allocator.template allocate<T>(capacity);
+    for (int i = 0; i < _size; ++i)
+      items[i] = (*this)[i];
+
+    _allocator.deallocate(_items, _capacity);
+    _items = items;
+    _capacity = capacity;
+    _head = 0;
+  }
+};
+
+#endif //! RING_BUFFER_H
@@ -0,0 +1,224 @@
+#include "Simulation.h"
+#include <algorithm> // For std::equal, std::max and std::min
+#include <cmath>     // For std::lround
+#include <cstdlib>   // For std::abs
+#include <iostream>  // For std::cout
+
+static_assert(LEVEL_ROWS == SCREEN_BLOCKS_HEIGHT, "Level columns must fill the screen");
+
+/**
+ * Parameterized Constructor
+ *
+ * @param data:        The layout of the Level, must outlive the Simulation
+ * @param pools:       Where to get objects from, must outlive the Simulation
+ * @param arena:       Where the containers come from, must outlive the Simulation
+ * @param startColumn: The column of the layout to start from, for practice runs
+ * @param stepLength:  The length of each step, in seconds
+ */
+Simulation::Simulation(const LevelData& data, ObjectPools& pools, Arena& arena, int startColumn, double stepLength) :
+  _objects(arena),
+  _pools(pools),
+  _cursor(data, startColumn),
+  _startColumn(startColumn),
+  _stepLength(stepLength),
+  _jumpBufferSteps(std::max(1, static_cast<int>(std::lround(JUMP_BUFFER_TIME / stepLength))))
+{
+  // Add the end to the level, reset() moves it into place
+  _end = new LevelEnd(Vertex(0, WINDOW_HEIGHT / 2));
+
+  reset();
+}
+
+// Destructor
+Simulation::~Simulation()
+{
+  // Give all of the objects back, the next attempt will reuse them
+  _objects.clear(_pools);
+
+  // Delete the LevelEnd
+  if (_end)
+    delete _end;
+
+  // Stop the worker
+  if (_streamer)
+    delete _streamer;
+}
+
+/**
+ * Goes back to the start, reusing everything already loaded
+ */
+void Simulation::reset()
+{
+  const LevelData& data = _cursor.getData();
+
+  // Give back the objects of the last attempt, and go back to the first column
+  _objects.clear(_pools);
+  _cursor.seek(_startColumn);
+
+  _player.reset();
+  _origin = 0.0;
+  _step = 0;
+  _blockCounter = 0;
+  _jumping = false;
+
+  // Add enough objects to make a starting platform for the player
+  for (int i = 0; i <= SCREEN_BLOCKS_WIDTH + 1; ++i)
+    _objects.add(_pools.acquire(OBJECT_BLOCK, Vertex(PIXELS_PER_BLOCK * i, WINDOW_HEIGHT - PIXELS_PER_BLOCK / 2)));
+
+  // Start reading ahead straight away when streaming, on the worker of the last attempt if there was one
+  if (_streamer)
+    _streamer->restart(data, _startColumn);
+  else if (STREAM_LEVEL_COLUMNS)
+    _streamer = new ColumnStreamer(data, _startColumn);
+
+  // Move the end to the end of the level, leaving an empty column after the last one
+  int length = data.getColumnCount() - _startColumn + 1;
+  _end->place(Vertex(WINDOW_WIDTH + length * PIXELS_PER_BLOCK + PIXELS_PER_BLOCK, WINDOW_HEIGHT / 2));
+}
+
+/**
+ * Presses or releases jump, takes effect on the next step
+ * Pressing queues a jump even if it is released before the next step
+ *
+ * @param jumping: True if jump is held
+ */
+void Simulation::setJumping(bool jumping)
+{
+  _jumping = jumping;
+  if (_jumping)
+    _player.jump(_jumpBufferSteps);
+}
+
+/**
+ * Runs one step
+ *
+ * @returns What happened in the step
+ */
+StepResult Simulation::step()
+{
+  // The camera only depends on the step, objects stay where they spawned and the camera moves past them
+  _step++;
+  double cameraX = getCameraX(1.0);
+
+  // Shift everything back once the camera is far along, so float positions stay precise
+  if (cameraX > CAMERA_REBASE_DISTANCE)
+  {
+    _objects.shift(CAMERA_REBASE_DISTANCE);
+    _end->setX(_end->getX() - CAMERA_REBASE_DISTANCE);
+    _origin += CAMERA_REBASE_DISTANCE;
+    cameraX -= CAMERA_REBASE_DISTANCE;
+  }
+
+  // Remove objects that have left the screen
+  // The frame being drawn can be up to a step behind, so wait until they are off that too
+  _objects.cull(getCameraX(0.0), _pools);
+
+  // If they player died, then stop
+  if (_player.step(_objects, cameraX, cameraX - getCameraX(0.0), _stepLength))
+    return STEP_DIED;
+
+  // Calculate how far the player is from the end
+  double distToEnd = _end->getX() - cameraX - _player.getX();
+  if (distToEnd < _end->getWidth() / 2 + _player.getWidth() / 2)
+    return STEP_FINISHED;
+
+  // Load the columns that are due
+  // Columns only depend on the step, so they are always in place by the time the player reaches them
+  while (_step * _stepLength / SECONDS_PER_BLOCK > _blockCounter)
+  {
+    _blockCounter++;
+    loadColumn();
+  }
+
+  // If the player is holding jump, queue a jump
+  if (_jumping)
+    _player.jump(_jumpBufferSteps);
+
+  return STEP_RUNNING;
+}
+
+/**
+ * Switches to an edited layout without restarting
+ * Columns that have already been loaded are left alone, every later column comes from the new layout
+ *
+ * @param data: The new layout, must outlive the Simulation
+ */
+void Simulation::patch(const LevelData& data)
+{
+  const LevelData& old = _cursor.getData();
+  int next = _startColumn + _blockCounter;
+
+  // Count the columns that haven't spawned yet and are different in the new layout
+  int changed = std::abs(data.getColumnCount() - old.getColumnCount());
+  int shared = std::min(data.getColumnCount(), old.getColumnCount());
+  if (next < shared)
+  {
+    LevelCursor oldColumns(old, next);
+    LevelCursor newColumns(data, next);
+    for (int i = next; i < shared; ++i)
+    {
+      Column a = oldColumns.next();
+      Column b = newColumns.next();
+      if (a.end() - a.begin() != b.end() - b.begin() or
+          not std::equal(a.begin(), a.end(), b.begin(), [](const Spawn& x, const Spawn& y) {
+            return x.type == y.type and x.y == y.y;
+          }))
+        changed++;
+    }
+  }
+
+  std::cout << "Reloaded " << data.getName() << ", " << changed << " unspawned columns changed\n";
+
+  // Move the end if the length changed, the same object is kept, like on a reset
+  if (data.getColumnCount() != old.getColumnCount())
+  {
+    double x = _end->getX() + (data.getColumnCount() - old.getColumnCount()) * PIXELS_PER_BLOCK;
+    _end->place(Vertex(x, WINDOW_HEIGHT / 2));
+  }
+
+  // Carry on from the next column of the new layout
+  _cursor.reset(data, next);
+  if (_streamer)
+    _streamer->restart(data, next);
+}
+
+/**
+ * Loads the next column of the layout
+ */
+void Simulation::loadColumn()
+{
+  // When streaming, the worker has already read the column
+  if (_streamer)
+  {
+    Spawn spawn;
+    while (_streamer->next(_startColumn + _blockCounter - 1, spawn))
+      spawnObject(spawn.type, spawn.y);
+    return;
+  }
+
+  if (_cursor.atEnd())
+    return;
+
+  for (const Spawn& i : _cursor.next())
+    spawnObject(i.type, i.y);
+}
+
+/**
+ * Adds an object to the newest column
+ *
+ * @param type: The ObjectType of the object
+ * @param row:  The row of the object, in blocks from the top of the screen
+ */
+void Simulation::spawnObject(int type, double row)
+{
+  double x = WINDOW_WIDTH + _blockCounter * PIXELS_PER_BLOCK + PIXELS_PER_BLOCK - _origin;
+  double y = row * PIXELS_PER_BLOCK + PIXELS_PER_BLOCK / 2;
+  Vertex pos(x, y);
+
+  // Allocate a new object based on type
+  Object* object = _pools.acquire(type, pos);
+  if (object)
+    _objects.add(object);
+  else
+    std::cout << "There was an invalid object type in level file.\n\n";
+}
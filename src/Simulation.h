@@ -0,0 +1,203 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "Arena.h"          // For Arena class
+#include "ColumnStreamer.h" // For ColumnStreamer class
+#include "LevelData.h"      // For LevelData and LevelCursor classes
+#include "LevelEnd.h"       // For LevelEnd class
+#include "ObjectPools.h"    // For ObjectPools class
+#include "ObjectStore.h"    // For ObjectStore class
+#include "Player.h"         // For Player class
+
+// What happened in a step of a Simulation
+enum StepResult
+{
+  STEP_RUNNING, // The attempt carries on
+  STEP_DIED,    // The player died
+  STEP_FINISHED // The player reached the end
+};
+
+// The game logic of a Level, run in fixed steps
+//
+// Every step is the same length whatever the frame rate, and the camera is
+// worked out from the number of steps, so the same jumps on the same steps always
+// give the same attempt
+// Nothing here draws, a Level draws the Simulation between its last two steps
+// Collisions are swept, so runs without a window can use much longer steps
+class Simulation
+{
+  ObjectStore _objects;     // The objects in the Level
+  ObjectPools& _pools;      // Where objects come from and go back to
+  Player _player;           // The player in the Level
+  LevelEnd* _end = nullptr; // The end of the Level
+
+  LevelCursor _cursor;                 // Reads the Level layout one column at a time
+  int _startColumn = 0;                // The column of the layout the attempt starts from
+  ColumnStreamer* _streamer = nullptr; // Reads the layout ahead on a worker, if streaming
+
+  double _stepLength;    // The length of each step, in seconds
+  int _jumpBufferSteps;  // How many steps a jump stays queued for
+  double _origin = 0.0;  // Distance the level coordinates have been shifted back, in pixels
+  int _step = 0;         // How many steps have run since the start
+  int _blockCounter = 0; // How many blocks have been loaded, not including the beginning platform
+  bool _jumping = false; // Is the jump button held
+
+public:
+  /**
+   * Parameterized Constructor
+   *
+   * @param data:        The layout of the Level, must outlive the Simulation
+   * @param pools:       Where to get objects from, must outlive the Simulation
+   * @param arena:       Where the containers come from, must outlive the Simulation
+   * @param startColumn: The column of the layout to start from, for practice runs
+   * @param stepLength:  The length of each step, in seconds
+   */
+  Simulation(const LevelData& data, ObjectPools& pools, Arena& arena, int startColumn = 0, double stepLength = SIMULATION_STEP);
+
+  // Delete copy constructor
+  Simulation(const Simulation&) = delete;
+
+  // Delete assignment operator
+  Simulation& operator=(const Simulation&) = delete;
+
+  // Destructor
+  ~Simulation();
+
+  /**
+   * Goes back to the start, reusing everything already loaded
+   */
+  void reset();
+
+  /**
+   * Presses or releases jump, takes effect on the next step
+   * Pressing queues a jump even if it is released before the next step
+   *
+   * @param jumping: True if jump is held
+   */
+  void setJumping(bool jumping);
+
+  /**
+   * Runs one step
+   *
+   * @returns What happened in the step
+   */
+  StepResult step();
+
+  /**
+   * Switches to an edited layout without restarting
+   * Columns that have already been loaded are left alone, every later column comes from the new layout
+   *
+   * @param data: The new layout, must outlive the Simulation
+   */
+  void patch(const LevelData& data);
+
+  /**
+   * Gets the time since the start, between the last two steps
+   *
+   * @param alpha: How far through the step, from 0 (the previous step) to 1 (the last step)
+   *
+   * @returns The time, in seconds
+   */
+  double getTime(double alpha) const
+  {
+    return _step > 0 ? (_step - 1 + alpha) * _stepLength : 0.0;
+  }
+
+  /**
+   * Gets the length of each step
+   *
+   * @returns The step length, in seconds
+   */
+  double getStepLength() const
+  {
+    return _stepLength;
+  }
+
+  /**
+   * Gets where the camera is, between the last two steps
+   *
+   * @param alpha: How far through the step, from 0 (the previous step) to 1 (the last step)
+   *
+   * @returns The x of the left side of the screen, in level coordinates
+   */
+  double getCameraX(double alpha) const
+  {
+    return getTime(alpha) * SCROLL_SPEED_PIXELS - _origin;
+  }
+
+  /**
+   * Gets how far the level coordinates have been shifted back
+   *
+   * @returns The distance, in pixels
+   */
+  double getOrigin() const
+  {
+    return _origin;
+  }
+
+  /**
+   * Gets the number of steps run since the start
+   *
+   * @returns The step count
+   */
+  int getStep() const
+  {
+    return _step;
+  }
+
+  /**
+   * Gets the objects in the Level
+   *
+   * @returns The objects
+   */
+  const ObjectStore& getObjects() const
+  {
+    return _objects;
+  }
+
+  /**
+   * Gets the player
+   *
+   * @returns The player
+   */
+  const Player& getPlayer() const
+  {
+    return _player;
+  }
+
+  /**
+   * Gets the column of the layout the attempt starts from
+   *
+   * @returns The start column
+   */
+  int getStartColumn() const
+  {
+    return _startColumn;
+  }
+
+  /**
+   * Gets the layout being played
+   *
+   * @returns The layout
+   */
+  const LevelData& getData() const
+  {
+    return _cursor.getData();
+  }
+
+private:
+  /**
+   * Loads the next column of the layout
+   */
+  void loadColumn();
+
+  /**
+   * Adds an object to the newest column
+   *
+   * @param type: The ObjectType of the object
+   * @param row:  The row of the object, in blocks from the top of the screen
+   */
+  void spawnObject(int type, double row);
+};
+
+#endif //! SIMULATION_H
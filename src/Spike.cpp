@@ -8,35 +8,21 @@
 Spike::Spike(const Vertex& pos) :
   Object(pos, PIXELS_PER_BLOCK, PIXELS_PER_BLOCK, SPIKE_FILE_NAME)
 {
+  // The hitbox is smaller than the image, so the spike is only deadly near its point
+  _hitbox.halfWidth = SPIKE_HITBOX_WIDTH / 2;
+  _hitbox.halfHeight = SPIKE_HITBOX_HEIGHT / 2;
+  place(pos);
 }
 
 /**
- * Gets the image y
+ * Moves the spike, used when it is reused from a pool
  *
- * @returns The image y position
+ * @param pos: The new position of the spike in the level
  */
-double Spike::getY() const
+void Spike::place(const Vertex& pos)
 {
-  // Shift up
-  return _image.getY() - SPIKE_HITBOX_OFFSET_Y;
-}
+  Object::place(pos);
 
-/**
- * Gets the image width
- *
- * @returns The image width
- */
-double Spike::getWidth() const
-{
-  return SPIKE_HITBOX_WIDTH;
-}
-
-/**
- * Gets the image height
- *
- * @returns The image height
- */
-double Spike::getHeight() const
-{
-  return SPIKE_HITBOX_HEIGHT;
+  // Shift the hitbox up, the bottom of the image is empty
+  _hitbox.y -= SPIKE_HITBOX_OFFSET_Y;
 }
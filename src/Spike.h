@@ -13,31 +13,12 @@ public:
    */
   Spike(const Vertex& pos);
 
-  // Need to override the get position and dimension functions
-  // The spike hitbox and image are not the same
-  // So to calculate the right collisions, getters must apply translations
-  // before returning values
-
-  /**
-   * Gets the image y
-   *
-   * @returns The image y position
-   */
-  double getY() const override;
-
-  /**
-   * Gets the image width
-   *
-   * @returns The image width
-   */
-  double getWidth() const override;
-
   /**
-   * Gets the image height
+   * Moves the spike, used when it is reused from a pool
    *
-   * @returns The image height
+   * @param pos: The new position of the spike in the level
    */
-  double getHeight() const override;
+  void place(const Vertex& pos) override;
 
   /**
    * Checks if the object kills the player on contact
@@ -0,0 +1,90 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic> // For std::atomic
+
+// A bounded, lock free queue for exactly one producer thread and one consumer thread
+//
+// CAPACITY must be a power of two
+template <typename T, unsigned CAPACITY>
+class SpscRing
+{
+  static_assert(CAPACITY > 0 and (CAPACITY & (CAPACITY - 1)) == 0, "SpscRing capacity must be a power of two");
+
+  // Pad the indexes onto separate cache lines so the threads don't fight over them
+  // (Padding rather than alignas, since new ignores extended alignment before C++17)
+  std::atomic<unsigned> _head; // Next slot to read, written by the consumer
+  char _headPadding[64];       // Keeps _tail off of _head's cache line
+  std::atomic<unsigned> _tail; // Next slot to write, written by the producer
+  char _tailPadding[64];       // Keeps _items off of _tail's cache line
+  T _items[CAPACITY];          // The queued items
+
+public:
+  // Default Constructor
+  SpscRing() :
+    _head(0),
+    _tail(0)
+  {
+  }
+
+  // Delete copy constructor
+  SpscRing(const SpscRing&) = delete;
+
+  // Delete assignment operator
+  SpscRing& operator=(const SpscRing&) = delete;
+
+  /**
+   * Adds an item to the back of the queue
+   * Only call from the producer thread
+   *
+   * @param value: The item to add
+   *
+   * @returns False if the queue is full
+   */
+  bool push(const T& value)
+  {
+    unsigned tail = _tail.load(std::memory_order_relaxed);
+    if (tail - _head.load(std::memory_order_acquire) == CAPACITY)
+      return false;
+
+    _items[tail & (CAPACITY - 1)] = value;
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Gets the item at the front of the queue without removing it
+   * Only call from the consumer thread
+   *
+   * @returns A pointer to the front item, or nullptr if the queue is empty
+   */
+  const T* front() const
+  {
+    unsigned head = _head.load(std::memory_order_relaxed);
+    if (head == _tail.load(std::memory_order_acquire))
+      return nullptr;
+
+    return &_items[head & (CAPACITY - 1)];
+  }
+
+  /**
+   * Removes the item at the front of the queue, which must not be empty
+   * Only call from the consumer thread
+   */
+  void pop()
+  {
+    _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /**
+   * Empties the queue
+   * Only call while neither thread is using the queue
+   */
+  void clear()
+  {
+    _head.store(0, std::memory_order_relaxed);
+    _tail.store(0, std::memory_order_relaxed);
+  }
+};
+
+#endif //! SPSC_RING_H
@@ -0,0 +1,218 @@
+#include "Constants.h"   // For PLAYER_STARTING_POS, SCROLL_SPEED_PIXELS and GRAVITY_PIXELS
+#include "LevelFormat.h" // For OBJECT_BLOCK and OBJECT_SPIKE
+#include "ObjectPools.h" // For ObjectPools class
+#include "ObjectStore.h" // For ObjectStore class
+#include "Player.h"      // For Player class
+#include <cmath>         // For std::abs
+#include <iostream>      // For std::cout
+
+// Regression checks for the swept collisions in Player::step, at step lengths up to 1/30 s
+//
+// Each check moves the player for one step from a known height and velocity, past objects
+// placed so the player reaches them at a known point in the step
+// Exits with 1 if any check fails
+
+// The step lengths every check runs at, in seconds
+const double STEP_LENGTHS[] = {1.0 / 240.0, 1.0 / 60.0, 1.0 / 30.0};
+
+// The player's half size, in pixels
+const double PLAYER_HALF_SIZE = PIXELS_PER_BLOCK / 2.0;
+
+/**
+ * Adds an object to a store, placed by its hitbox rather than its sprite
+ *
+ * @param store: The store, objects have to be added left to right
+ * @param pools: Where the object comes from
+ * @param type:  The ObjectType
+ * @param x:     The centre x of the hitbox
+ * @param y:     The centre y of the hitbox
+ */
+void addObject(ObjectStore& store, ObjectPools& pools, int type, double x, double y)
+{
+  Object* object = pools.acquire(type, Vertex(0.0, 0.0));
+  Hitbox offset = object->getHitbox();
+  object->place(Vertex(x - offset.x, y - offset.y));
+  store.add(object);
+}
+
+/**
+ * Runs one step of a player past some objects
+ *
+ * @param player:     The player, already moving, its last step is swept
+ * @param store:      The objects
+ * @param stepLength: The length of the step, in seconds
+ *
+ * @returns True if the player died
+ */
+bool sweep(Player& player, const ObjectStore& store, double stepLength)
+{
+  // The player starts at PLAYER_STARTING_POS in the objects' coordinates, and scrolls right over the step
+  double scroll = SCROLL_SPEED_PIXELS * stepLength;
+  return player.step(store, scroll, scroll, stepLength);
+}
+
+/**
+ * Starts a player falling, so its next step moves it down
+ *
+ * @param player:     The player
+ * @param y:          Where the next step starts
+ * @param velocity:   The y velocity, in pixels per second
+ * @param stepLength: The length of the step, in seconds
+ *
+ * @returns How far the next step moves the player down
+ */
+double startFalling(Player& player, double y, double velocity, double stepLength)
+{
+  ObjectStore empty;
+  player.setMotion(y, velocity);
+  player.step(empty, 0.0, 0.0, stepLength);
+  return player.getY() - y;
+}
+
+/**
+ * Falls diagonally into the corner of a spike, starting inside its y band and
+ * entering it on x a tenth of the way through the step
+ *
+ * @param stepLength: The length of the step, in seconds
+ *
+ * @returns True if the player died
+ */
+bool cornerOfSpike(double stepLength)
+{
+  ObjectPools pools;
+  ObjectStore store;
+  Player player;
+
+  double startY = PLAYER_STARTING_POS.second;
+  double moveY = startFalling(player, startY, 1500.0, stepLength);
+  double scroll = SCROLL_SPEED_PIXELS * stepLength;
+
+  // The player leaves the y band halfway through the step, after reaching the spike on x
+  Object* probe = pools.acquire(OBJECT_SPIKE, Vertex(0.0, 0.0));
+  double reachX = PLAYER_HALF_SIZE + probe->getHitbox().halfWidth;
+  double reachY = PLAYER_HALF_SIZE + probe->getHitbox().halfHeight;
+  pools.release(probe);
+
+  double x = PLAYER_STARTING_POS.first + 0.1 * scroll + reachX;
+  double y = startY + 0.5 * moveY - reachY;
+  addObject(store, pools, OBJECT_SPIKE, x, y);
+
+  bool died = sweep(player, store, stepLength);
+  store.clear(pools);
+  return died;
+}
+
+/**
+ * Falls 30 px past the top of a block in one step, starting 5 px above it, but reaches
+ * its side nine tenths of the way through the step, the bottom of the player 22 px below its top
+ *
+ * @param stepLength: The length of the step, in seconds
+ *
+ * @returns True if the player died
+ */
+bool sideOfBlock(double stepLength)
+{
+  ObjectPools pools;
+  ObjectStore store;
+  Player player;
+
+  double startY = PLAYER_STARTING_POS.second;
+  double velocity = 30.0 / stepLength - GRAVITY_PIXELS * stepLength;
+  double moveY = startFalling(player, startY, velocity, stepLength);
+  double scroll = SCROLL_SPEED_PIXELS * stepLength;
+
+  double x = PLAYER_STARTING_POS.first + 0.9 * scroll + PIXELS_PER_BLOCK;
+  double top = startY + 0.9 * moveY - 22.0;
+  addObject(store, pools, OBJECT_BLOCK, x, top + PIXELS_PER_BLOCK);
+
+  bool died = sweep(player, store, stepLength);
+  store.clear(pools);
+  return died;
+}
+
+/**
+ * Falls onto the top of a block from above, halfway through the step
+ *
+ * @param stepLength: The length of the step, in seconds
+ *
+ * @returns True if the player landed on it and lived
+ */
+bool topOfBlock(double stepLength)
+{
+  ObjectPools pools;
+  ObjectStore store;
+  Player player;
+
+  double startY = PLAYER_STARTING_POS.second;
+  double moveY = startFalling(player, startY, 600.0, stepLength);
+
+  double top = startY + 0.5 * moveY;
+  addObject(store, pools, OBJECT_BLOCK, PLAYER_STARTING_POS.first, top + PIXELS_PER_BLOCK);
+
+  bool died = sweep(player, store, stepLength);
+  store.clear(pools);
+
+  // Landing snaps the player to the top, then gravity moves it for a step from standing
+  double fall = GRAVITY_PIXELS * stepLength * stepLength;
+  return not died and std::abs(player.getY() - (top + fall)) < 0.001;
+}
+
+/**
+ * Slides off a block onto the next one along, with their tops level
+ *
+ * @param stepLength: The length of the step, in seconds
+ *
+ * @returns True if the player lived
+ */
+bool acrossBlocks(double stepLength)
+{
+  ObjectPools pools;
+  ObjectStore store;
+  Player player;
+
+  // Resting on the first block, gravity sinks the player a little into it every step
+  double top = PLAYER_STARTING_POS.second;
+  startFalling(player, top, 0.0, stepLength);
+  double scroll = SCROLL_SPEED_PIXELS * stepLength;
+
+  double x = PLAYER_STARTING_POS.first + 0.5 * scroll + PIXELS_PER_BLOCK / 2.0;
+  addObject(store, pools, OBJECT_BLOCK, x - PIXELS_PER_BLOCK, top + PIXELS_PER_BLOCK);
+  addObject(store, pools, OBJECT_BLOCK, x, top + PIXELS_PER_BLOCK);
+
+  bool died = sweep(player, store, stepLength);
+  store.clear(pools);
+  return not died;
+}
+
+/**
+ * Prints the result of a check
+ *
+ * @param name:       What was checked
+ * @param stepLength: The step length it was checked at, in seconds
+ * @param passed:     True if it passed
+ *
+ * @returns 1 if it failed, 0 if it passed
+ */
+int report(const char* name, double stepLength, bool passed)
+{
+  std::cout << (passed ? "ok   " : "FAIL ") << name << " at 1/" << static_cast<int>(1.0 / stepLength + 0.5)
+            << " s\n";
+  return passed ? 0 : 1;
+}
+
+int main()
+{
+  int failures = 0;
+  for (double stepLength : STEP_LENGTHS)
+  {
+    failures += report("corner of a spike kills", stepLength, cornerOfSpike(stepLength));
+    failures += report("side of a block kills", stepLength, sideOfBlock(stepLength));
+    failures += report("top of a block lands", stepLength, topOfBlock(stepLength));
+    failures += report("level blocks carry the player", stepLength, acrossBlocks(stepLength));
+  }
+
+  if (failures)
+    std::cout << failures << " checks failed\n";
+
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,85 @@
+#include "LevelFormat.h"  // For COMPILED_LEVEL_EXTENSION
+#include "LevelWatcher.h" // For LevelWatcher class
+#include <chrono>         // For std::chrono::milliseconds
+#include <cstdio>         // For std::remove and std::rename
+#include <fstream>        // For ofstream
+#include <iostream>       // For std::cout
+#include <string>         // For std::string
+#include <thread>         // For std::this_thread::sleep_for
+
+// Checks that LevelWatcher reports writes to a level's files, and nothing else
+//
+// The level is written to the working directory, and removed afterwards
+// Exits with 1 if any check fails
+
+// Name of the level the checks write
+const char* const LEVEL_NAME = "watcher_test_level";
+
+/**
+ * Writes a file, the same way an editor or lvlc would
+ *
+ * @param path: The file to write
+ * @param text: What to write
+ */
+void writeFile(const std::string& path, const char* text)
+{
+#ifndef __linux__
+  // Write times are only kept to the second here, see getModifiedTime()
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+#endif
+
+  std::ofstream file(path);
+  file << text;
+}
+
+/**
+ * Prints the result of a check
+ *
+ * @param name:   What was checked
+ * @param passed: True if it passed
+ *
+ * @returns 1 if it failed, 0 if it passed
+ */
+int report(const char* name, bool passed)
+{
+  std::cout << (passed ? "ok   " : "FAIL ") << name << "\n";
+  return passed ? 0 : 1;
+}
+
+int main()
+{
+  std::string name = LEVEL_NAME;
+  std::string text = name + ".lvl";
+  std::string compiled = name + COMPILED_LEVEL_EXTENSION;
+  std::string temporary = compiled + ".tmp";
+  std::string other = name + "_other.lvl";
+
+  writeFile(text, "11 block\n");
+
+  int failures = 0;
+  {
+    LevelWatcher watcher(name);
+    failures += report("nothing written yet", not watcher.poll());
+
+    writeFile(text, "11 block\n11 block|10 spike\n");
+    failures += report("saving the text level", watcher.poll());
+    failures += report("reported once", not watcher.poll());
+
+    writeFile(temporary, "GDLV");
+    std::rename(temporary.c_str(), compiled.c_str());
+    failures += report("renaming a compiled level into place", watcher.poll());
+
+    writeFile(other, "11 block\n");
+    failures += report("another level's file", not watcher.poll());
+  }
+
+  std::remove(text.c_str());
+  std::remove(compiled.c_str());
+  std::remove(temporary.c_str());
+  std::remove(other.c_str());
+
+  if (failures)
+    std::cout << failures << " checks failed\n";
+
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,324 @@
+#include "LevelCompiler.h"
+#include "LevelCodec.h"  // For compressBytes
+#include "LevelParser.h" // For LevelParser class
+#include "MappedFile.h"  // For MappedFile class
+#include <algorithm>     // For std::min and std::max
+#include <cstdio>        // For std::remove
+#include <fstream>       // For ofstream
+#include <iostream>      // For std::cout
+#include <unordered_map> // For std::unordered_map
+#include <vector>        // For std::vector
+
+// Default Constructor
+LevelCompiler::LevelCompiler()
+{
+  _offsets.pushBack(0);
+}
+
+/**
+ * Parses a text level, replacing any columns already added
+ *
+ * @param path: The text level file
+ *
+ * @returns False if the file couldn't be read or was malformed
+ */
+bool LevelCompiler::parse(const std::string& path)
+{
+  MappedFile text;
+  if (not text.open(path))
+  {
+    std::cout << "Could not open " << path << "\n";
+    return false;
+  }
+
+  ParseError error;
+  if (not LevelParser::parse(text.getData(), text.getData() + text.getSize(), _offsets, _spawns, error))
+  {
+    std::cout << path << ":" << error.line << ":" << error.column << ": " << error.message << "\n";
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Adds a column to the end of the level
+ *
+ * @param first: The first object in the column
+ * @param last:  One past the last object in the column
+ */
+void LevelCompiler::addColumn(const Spawn* first, const Spawn* last)
+{
+  for (const Spawn* i = first; i != last; ++i)
+    _spawns.pushBack(*i);
+  _offsets.pushBack(_spawns.getSize());
+}
+
+/**
+ * Checks that the level can be played, printing every problem found
+ *
+ * @param name: The name to report problems against
+ *
+ * @returns True if the level is valid
+ */
+bool LevelCompiler::validate(const std::string& name) const
+{
+  bool valid = true;
+
+  for (int column = 0; column < getColumnCount(); ++column)
+  {
+    // Track which rows of the column are taken
+    bool occupied[LEVEL_ROWS] = {};
+
+    for (uint32_t i = _offsets[column]; i < _offsets[column + 1]; ++i)
+    {
+      const Spawn& spawn = _spawns.begin()[i];
+
+      if (spawn.type >= OBJECT_TYPE_COUNT)
+      {
+        std::cout << name << ":" << column + 1 << ": unknown object type " << int(spawn.type) << "\n";
+        valid = false;
+      }
+      else if (spawn.y >= LEVEL_ROWS)
+      {
+        std::cout << name << ":" << column + 1 << ": row " << int(spawn.y) << " is below the bottom of the screen\n";
+        valid = false;
+      }
+      else if (occupied[spawn.y])
+      {
+        std::cout << name << ":" << column + 1 << ": more than one object in row " << int(spawn.y) << "\n";
+        valid = false;
+      }
+      else
+      {
+        occupied[spawn.y] = true;
+      }
+    }
+  }
+
+  return valid;
+}
+
+/**
+ * Writes the compiled level
+ *
+ * @param path:  The file to write
+ * @param stats: Set to the sizes of the compiled level
+ *
+ * @returns False if the file couldn't be written
+ */
+bool LevelCompiler::write(const std::string& path, CompileStats& stats) const
+{
+  Array<uint32_t> entryOffsets;
+  Array<Spawn> entrySpawns;
+  Array<ColumnRun> runs;
+  std::unordered_map<std::string, uint32_t> dictionary;
+
+  entryOffsets.pushBack(0);
+
+  for (int column = 0; column < getColumnCount(); ++column)
+  {
+    // Identical columns have identical bytes, so use them as the dictionary key
+    const Spawn* first = _spawns.begin() + _offsets[column];
+    const Spawn* last = _spawns.begin() + _offsets[column + 1];
+    std::string key(reinterpret_cast<const char*>(first), reinterpret_cast<const char*>(last));
+
+    // Intern the column, adding it to the dictionary the first time it is seen
+    auto found = dictionary.find(key);
+    uint32_t entry;
+    if (found == dictionary.end())
+    {
+      entry = static_cast<uint32_t>(entryOffsets.getSize() - 1);
+      if (entry >= MAX_COMPILED_ENTRIES)
+      {
+        std::cout << "Could not compile " << path << ", it has more than " << MAX_COMPILED_ENTRIES
+                  << " distinct columns, use --chunked instead\n";
+        return false;
+      }
+
+      dictionary[key] = entry;
+
+      for (const Spawn* i = first; i != last; ++i)
+        entrySpawns.pushBack(*i);
+      entryOffsets.pushBack(entrySpawns.getSize());
+    }
+    else
+    {
+      entry = found->second;
+    }
+
+    // Only start a new run when the column differs from the one before it, or the run is full
+    ColumnRun* lastRun = runs.getSize() > 0 ? &runs[runs.getSize() - 1] : nullptr;
+    if (lastRun and lastRun->entry == entry and lastRun->columns < UINT16_MAX)
+    {
+      lastRun->columns++;
+    }
+    else
+    {
+      ColumnRun run;
+      run.entry = static_cast<uint16_t>(entry);
+      run.columns = 1;
+      runs.pushBack(run);
+    }
+  }
+
+  // Store where every RUN_BLOCK_SIZE-th run starts, so columns can be found without reading every run
+  Array<uint32_t> runStarts;
+  uint32_t start = 0;
+  for (int i = 0; i < runs.getSize(); ++i)
+  {
+    if (i % RUN_BLOCK_SIZE == 0)
+      runStarts.pushBack(start);
+    start += runs[i].columns;
+  }
+
+  LevelFileHeader header;
+  header.magic = COMPILED_LEVEL_MAGIC;
+  header.version = COMPILED_LEVEL_VERSION;
+  header.columnCount = static_cast<uint32_t>(getColumnCount());
+  header.entryCount = static_cast<uint32_t>(entryOffsets.getSize() - 1);
+  header.spawnCount = static_cast<uint32_t>(entrySpawns.getSize());
+  header.runCount = static_cast<uint32_t>(runs.getSize());
+
+  // Written beside the level then moved over it, since the game may still be reading the old one
+  std::string temporary = path + TEMPORARY_FILE_EXTENSION;
+  std::ofstream outFile(temporary, std::ios::binary);
+  if (not outFile.is_open())
+  {
+    std::cout << "Could not create " << temporary << "\n";
+    return false;
+  }
+
+  // Spawns are 2 bytes, so pad them back to 4 byte alignment for the runs
+  const char padding[4] = {};
+  size_t spawnBytes = entrySpawns.getSize() * sizeof(Spawn);
+
+  outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  outFile.write(reinterpret_cast<const char*>(entryOffsets.begin()), entryOffsets.getSize() * sizeof(uint32_t));
+  outFile.write(reinterpret_cast<const char*>(entrySpawns.begin()), spawnBytes);
+  outFile.write(padding, (4 - spawnBytes % 4) % 4);
+  outFile.write(reinterpret_cast<const char*>(runStarts.begin()), runStarts.getSize() * sizeof(uint32_t));
+  outFile.write(reinterpret_cast<const char*>(runs.begin()), runs.getSize() * sizeof(ColumnRun));
+
+  size_t bytes = static_cast<size_t>(outFile.tellp());
+  outFile.close();
+  if (not outFile)
+  {
+    std::remove(temporary.c_str());
+    std::cout << "Could not write " << temporary << "\n";
+    return false;
+  }
+
+  if (not replaceFile(temporary, path))
+  {
+    std::cout << "Could not replace " << path << "\n";
+    return false;
+  }
+
+  stats.columns = header.columnCount;
+  stats.entries = header.entryCount;
+  stats.runs = header.runCount;
+  stats.spawns = header.spawnCount;
+  stats.bytes = bytes;
+  return true;
+}
+
+/**
+ * Writes the level as independently compressed chunks
+ *
+ * @param path:         The file to write
+ * @param chunkColumns: How many columns to put in each chunk
+ * @param stats:        Set to the sizes of the chunked level
+ *
+ * @returns False if the file couldn't be written
+ */
+bool LevelCompiler::writeChunked(const std::string& path, int chunkColumns, CompileStats& stats) const
+{
+  int columnCount = getColumnCount();
+  int chunkCount = (columnCount + chunkColumns - 1) / chunkColumns;
+
+  ChunkedFileHeader header;
+  header.magic = CHUNKED_LEVEL_MAGIC;
+  header.version = CHUNKED_LEVEL_VERSION;
+  header.columnCount = static_cast<uint32_t>(columnCount);
+  header.chunkColumns = static_cast<uint32_t>(chunkColumns);
+  header.chunkCount = static_cast<uint32_t>(chunkCount);
+  header.maxChunkSize = 0;
+
+  std::vector<ChunkEntry> index(chunkCount);
+  std::vector<uint8_t> compressed;
+  uint32_t offset = static_cast<uint32_t>(sizeof(header) + chunkCount * sizeof(ChunkEntry));
+
+  for (int chunk = 0; chunk < chunkCount; ++chunk)
+  {
+    int first = chunk * chunkColumns;
+    int last = std::min(first + chunkColumns, columnCount);
+
+    // Lay the chunk out as its column counts followed by its spawns
+    std::vector<uint8_t> raw;
+    for (int column = first; column < last; ++column)
+    {
+      uint32_t count = _offsets[column + 1] - _offsets[column];
+      if (count > 0xFFFF)
+      {
+        std::cout << "Column " << column + 1 << " has too many objects to chunk\n";
+        return false;
+      }
+      raw.push_back(static_cast<uint8_t>(count & 0xFF));
+      raw.push_back(static_cast<uint8_t>(count >> 8));
+    }
+
+    const uint8_t* spawnBytes = reinterpret_cast<const uint8_t*>(_spawns.begin() + _offsets[first]);
+    raw.insert(raw.end(), spawnBytes, spawnBytes + (_offsets[last] - _offsets[first]) * sizeof(Spawn));
+
+    // Compress the chunk on its own, so it can be read without its neighbours
+    size_t start = compressed.size();
+    compressed.resize(start + compressBound(raw.size()));
+    size_t size = compressBytes(raw.data(), raw.size(), compressed.data() + start);
+    compressed.resize(start + size);
+
+    index[chunk].offset = offset;
+    index[chunk].compressedSize = static_cast<uint32_t>(size);
+    index[chunk].size = static_cast<uint32_t>(raw.size());
+    index[chunk].spawnCount = _offsets[last] - _offsets[first];
+    offset += static_cast<uint32_t>(size);
+
+    header.maxChunkSize = std::max(header.maxChunkSize, index[chunk].size);
+  }
+
+  // Written beside the level then moved over it, since the game may still be reading the old one
+  std::string temporary = path + TEMPORARY_FILE_EXTENSION;
+  std::ofstream outFile(temporary, std::ios::binary);
+  if (not outFile.is_open())
+  {
+    std::cout << "Could not create " << temporary << "\n";
+    return false;
+  }
+
+  outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  outFile.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(ChunkEntry));
+  outFile.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+
+  size_t bytes = static_cast<size_t>(outFile.tellp());
+  outFile.close();
+  if (not outFile)
+  {
+    std::remove(temporary.c_str());
+    std::cout << "Could not write " << temporary << "\n";
+    return false;
+  }
+
+  if (not replaceFile(temporary, path))
+  {
+    std::cout << "Could not replace " << path << "\n";
+    return false;
+  }
+
+  stats.columns = columnCount;
+  stats.entries = 0;
+  stats.runs = 0;
+  stats.spawns = _spawns.getSize();
+  stats.chunks = chunkCount;
+  stats.bytes = bytes;
+  return true;
+}
@@ -0,0 +1,89 @@
+#ifndef LEVEL_COMPILER_H
+#define LEVEL_COMPILER_H
+
+#include "Array.h"       // For Array class
+#include "LevelFormat.h" // For Spawn and the compiled layout
+#include <cstddef>       // For size_t
+#include <string>        // For std::string
+
+// Sizes of a compiled level
+struct CompileStats
+{
+  int columns = 0;  // Columns in the level
+  int entries = 0;  // Distinct columns in the dictionary
+  int runs = 0;     // Runs of identical columns
+  int spawns = 0;   // Objects stored in the dictionary
+  int chunks = 0;   // Compressed chunks, for chunked levels
+  size_t bytes = 0; // Size of the compiled file
+};
+
+// Builds compiled (.lvc) levels offline
+// Identical columns are interned into a dictionary, and repeated columns are run length encoded
+class LevelCompiler
+{
+  Array<uint32_t> _offsets; // Index of the first spawn in each column, plus the end
+  Array<Spawn> _spawns;     // Every object in the level, in column order
+
+public:
+  // Default Constructor
+  LevelCompiler();
+
+  /**
+   * Parses a text level, replacing any columns already added
+   *
+   * @param path: The text level file
+   *
+   * @returns False if the file couldn't be read or was malformed
+   */
+  bool parse(const std::string& path);
+
+  /**
+   * Adds a column to the end of the level
+   *
+   * @param first: The first object in the column
+   * @param last:  One past the last object in the column
+   */
+  void addColumn(const Spawn* first, const Spawn* last);
+
+  /**
+   * Gets the length of the level
+   *
+   * @returns The number of columns added
+   */
+  int getColumnCount() const
+  {
+    return _offsets.getSize() - 1;
+  }
+
+  /**
+   * Checks that the level can be played, printing every problem found
+   *
+   * @param name: The name to report problems against
+   *
+   * @returns True if the level is valid
+   */
+  bool validate(const std::string& name) const;
+
+  /**
+   * Writes the compiled level
+   *
+   * @param path:  The file to write
+   * @param stats: Set to the sizes of the compiled level
+   *
+   * @returns False if the file couldn't be written
+   */
+  bool write(const std::string& path, CompileStats& stats) const;
+
+  /**
+   * Writes the level as independently compressed chunks
+   *
+   * @param path:         The file to write
+   * @param chunkColumns: How many columns to put in each chunk
+   * @param stats:        Set to the sizes of the chunked level
+   *
+   * @returns False if the file couldn't be written
+   */
+  bool writeChunked(const std::string& path, int chunkColumns, CompileStats& stats) const;
+};
+
+#endif //! LEVEL_COMPILER_H
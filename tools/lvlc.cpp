@@ -0,0 +1,55 @@
+#include "LevelCompiler.h" // For LevelCompiler class
+#include <iostream>        // For std::cout
+#include <string>          // For std::string
+
+// Validates a text level (.lvl) and compiles it into a compiled level (.lvc)
+//
+// Usage: lvlc [--chunked] <input.lvl> [output]
+//
+// With --chunked, writes a chunked level (.lvz) of compressed chunks instead,
+// for very long levels that need to be started from any column
+// Exits with 1 without writing anything if the level is invalid
+
+int main(int argc, char** argv)
+{
+  // Check for the chunked flag
+  bool chunked = argc > 1 and std::string(argv[1]) == "--chunked";
+  int first = chunked ? 2 : 1;
+
+  if (argc <= first)
+  {
+    std::cout << "Usage: lvlc [--chunked] <input.lvl> [output]\n";
+    return 1;
+  }
+
+  // Default the output to the input name with the right extension
+  std::string input = argv[first];
+  std::string extension = chunked ? CHUNKED_LEVEL_EXTENSION : COMPILED_LEVEL_EXTENSION;
+  std::string output = argc > first + 1 ? argv[first + 1] : input.substr(0, input.rfind('.')) + extension;
+
+  LevelCompiler compiler;
+  if (not compiler.parse(input) or not compiler.validate(input))
+  {
+    std::cout << input << " was not compiled\n";
+    return 1;
+  }
+
+  CompileStats stats;
+  if (chunked)
+  {
+    if (not compiler.writeChunked(output, CHUNK_COLUMNS, stats))
+      return 1;
+
+    std::cout << "Compiled " << stats.columns << " columns into " << output << "\n";
+    std::cout << "  " << stats.chunks << " chunks, " << stats.spawns << " objects, " << stats.bytes << " bytes\n";
+    return 0;
+  }
+
+  if (not compiler.write(output, stats))
+    return 1;
+
+  std::cout << "Compiled " << stats.columns << " columns into " << output << "\n";
+  std::cout << "  " << stats.entries << " distinct columns, " << stats.runs << " runs, " << stats.spawns
+            << " objects, " << stats.bytes << " bytes\n";
+  return 0;
+}
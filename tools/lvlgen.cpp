@@ -0,0 +1,203 @@
+#include "LevelCompiler.h" // For LevelCompiler class
+#include "MappedFile.h"    // For replaceFile
+#include "ObjectTypes.h"   // For LevelObjects
+#include <cstdint>         // For uint64_t
+#include <cstdio>          // For sscanf and std::remove
+#include <cstdlib>         // For atoi, atof and strtoull
+#include <cstring>         // For strcmp
+#include <fstream>         // For ofstream
+#include <iostream>        // For std::cout
+#include <string>          // For std::string
+
+// Generates levels of any length from a seed, for stress and scale testing
+//
+// Usage: lvlgen <name> [options]
+//   --seed N         Seed for the generator (default 1)
+//   --columns N      Length of the level (default 10000)
+//   --density F      Chance of a column having any objects, 0 to 1 (default 0.5)
+//   --mix B,S,P      Relative weights of blocks, spikes and platforms (default 6,3,1)
+//   --max-height N   Tallest stack of objects, 1 to 12 (default 4)
+//   --dense          Fill every column to the max height (use --max-height 12 to fill the screen)
+//
+// Writes <name>.lvl, and the compiled <name>.lvc and chunked <name>.lvz forms
+// The same options and seed always produce the same files
+
+// A small deterministic random number generator (SplitMix64)
+// Used instead of <random> so every platform generates the same levels
+class LevelRandom
+{
+  uint64_t _state; // The current state
+
+public:
+  /**
+   * Parameterized Constructor
+   *
+   * @param seed: The seed
+   */
+  LevelRandom(uint64_t seed) :
+    _state(seed)
+  {
+  }
+
+  /**
+   * Gets the next random number
+   *
+   * @returns 64 random bits
+   */
+  uint64_t next()
+  {
+    uint64_t z = (_state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  /**
+   * Gets a random number in a range
+   *
+   * @param count: The number of possible values
+   *
+   * @returns A value from 0 to count - 1
+   */
+  int below(int count)
+  {
+    return static_cast<int>(next() % static_cast<uint64_t>(count));
+  }
+
+  /**
+   * Gets a random fraction
+   *
+   * @returns A value from 0 (inclusive) to 1 (exclusive)
+   */
+  double fraction()
+  {
+    return (next() >> 11) * (1.0 / 9007199254740992.0);
+  }
+};
+
+int main(int argc, char** argv)
+{
+  if (argc < 2)
+  {
+    std::cout << "Usage: lvlgen <name> [--seed N] [--columns N] [--density F] [--mix B,S,P] [--max-height N] "
+                 "[--dense]\n";
+    return 1;
+  }
+
+  std::string name = argv[1];
+  uint64_t seed = 1;
+  int columns = 10000;
+  double density = 0.5;
+  int weights[OBJECT_TYPE_COUNT] = {6, 3, 1};
+  int maxHeight = 4;
+  bool dense = false;
+
+  // Read the options
+  for (int i = 2; i < argc; ++i)
+  {
+    bool hasValue = i + 1 < argc;
+    if (strcmp(argv[i], "--seed") == 0 and hasValue)
+      seed = strtoull(argv[++i], nullptr, 10);
+    else if (strcmp(argv[i], "--columns") == 0 and hasValue)
+      columns = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--density") == 0 and hasValue)
+      density = atof(argv[++i]);
+    else if (strcmp(argv[i], "--mix") == 0 and hasValue)
+    {
+      if (sscanf(argv[++i], "%d,%d,%d", &weights[0], &weights[1], &weights[2]) != 3)
+      {
+        std::cout << "--mix needs three weights, e.g. 6,3,1\n";
+        return 1;
+      }
+    }
+    else if (strcmp(argv[i], "--max-height") == 0 and hasValue)
+      maxHeight = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--dense") == 0)
+      dense = true;
+    else
+    {
+      std::cout << "Unknown option " << argv[i] << "\n";
+      return 1;
+    }
+  }
+
+  int totalWeight = weights[0] + weights[1] + weights[2];
+  if (columns < 1 or maxHeight < 1 or maxHeight > LEVEL_ROWS or totalWeight <= 0 or weights[0] < 0 or
+      weights[1] < 0 or weights[2] < 0)
+  {
+    std::cout << "Invalid options\n";
+    return 1;
+  }
+
+  // Written beside the level then moved over it, since the game may be reading the old one
+  std::string textPath = name + ".lvl";
+  std::string temporary = textPath + TEMPORARY_FILE_EXTENSION;
+  std::ofstream text(temporary);
+  if (not text.is_open())
+  {
+    std::cout << "Could not create " << temporary << "\n";
+    return 1;
+  }
+
+  LevelRandom random(seed);
+  LevelCompiler compiler;
+  Spawn column[LEVEL_ROWS];
+
+  for (int i = 0; i < columns; ++i)
+  {
+    // Decide how tall the stack in this column is, from the bottom row up
+    int height = 0;
+    if (dense)
+      height = maxHeight;
+    else if (random.fraction() < density)
+      height = 1 + random.below(maxHeight);
+
+    for (int j = 0; j < height; ++j)
+    {
+      // Pick the type by weight
+      int pick = random.below(totalWeight);
+      int type = 0;
+      while (pick >= weights[type])
+        pick -= weights[type++];
+
+      column[j].type = static_cast<uint8_t>(type);
+      column[j].y = static_cast<uint8_t>(LEVEL_ROWS - 1 - j);
+
+      if (j > 0)
+        text << '|';
+      text << int(column[j].y) << ' ' << LevelObjects::getName(type);
+    }
+    text << '\n';
+
+    compiler.addColumn(column, column + height);
+  }
+
+  text.close();
+  if (not text)
+  {
+    std::remove(temporary.c_str());
+    std::cout << "Could not write " << temporary << "\n";
+    return 1;
+  }
+
+  if (not replaceFile(temporary, textPath))
+  {
+    std::cout << "Could not replace " << textPath << "\n";
+    return 1;
+  }
+
+  // The generator can't produce invalid levels, but check anyway
+  if (not compiler.validate(textPath))
+    return 1;
+
+  CompileStats compiled;
+  CompileStats chunked;
+  if (not compiler.write(name + COMPILED_LEVEL_EXTENSION, compiled) or
+      not compiler.writeChunked(name + CHUNKED_LEVEL_EXTENSION, CHUNK_COLUMNS, chunked))
+    return 1;
+
+  std::cout << "Generated " << columns << " columns with " << chunked.spawns << " objects\n";
+  std::cout << "  " << name << COMPILED_LEVEL_EXTENSION << ": " << compiled.bytes << " bytes\n";
+  std::cout << "  " << name << CHUNKED_LEVEL_EXTENSION << ": " << chunked.bytes << " bytes\n";
+  return 0;
+}
@@ -0,0 +1,94 @@
+#include "Arena.h"       // For Arena class
+#include "Constants.h"   // For LEVEL_ARENA_SIZE
+#include "LevelData.h"   // For LevelData class
+#include "ObjectPools.h" // For ObjectPools class
+#include "Replay.h"      // For Replay class
+#include "Simulation.h"  // For Simulation class
+#include <iostream>      // For std::cout
+#include <string>        // For std::string
+
+// Replays recorded attempts and checks they end the same way, on the same step
+//
+// Usage: replay <level> <replay.gdr>...
+//
+// The level is given without an extension, the same as to the game
+// Exits with 1 if any replay was recorded on a different layout or ends differently,
+// so a folder of replays works as a regression test for the physics
+
+/**
+ * Gets the name of a step result
+ *
+ * @param result: The result
+ *
+ * @returns The name
+ */
+static const char* getResultName(StepResult result)
+{
+  switch (result)
+  {
+  case STEP_DIED:
+    return "died";
+  case STEP_FINISHED:
+    return "finished";
+  default:
+    return "was still running";
+  }
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 3)
+  {
+    std::cout << "Usage: replay <level> <replay.gdr>...\n";
+    return 1;
+  }
+
+  LevelData data;
+  if (not data.load(argv[1]))
+    return 1;
+  uint64_t levelHash = hashLayout(data);
+
+  ObjectPools pools;
+  Arena arena(LEVEL_ARENA_SIZE);
+  int failures = 0;
+
+  for (int i = 2; i < argc; ++i)
+  {
+    std::string path = argv[i];
+    Replay replay;
+    if (not replay.load(path))
+    {
+      failures++;
+      continue;
+    }
+
+    if (replay.getLevelHash() != levelHash)
+    {
+      std::cout << path << ": recorded on a different layout of " << argv[1] << "\n";
+      failures++;
+      continue;
+    }
+
+    // Every replay gets a fresh arena, the same as an attempt in the game
+    arena.reset();
+    Simulation simulation(data, pools, arena, replay.getStartColumn(), replay.getStepLength());
+    StepResult result = replay.play(simulation);
+
+    if (result != replay.getResult() or simulation.getStep() != replay.getEndStep())
+    {
+      std::cout << path << ": MISMATCH, recorded " << getResultName(replay.getResult()) << " on step "
+                << replay.getEndStep() << ", replayed " << getResultName(result) << " on step " << simulation.getStep()
+                << "\n";
+      failures++;
+      continue;
+    }
+
+    std::cout << path << ": ok, " << getResultName(result) << " on step " << simulation.getStep() << " after "
+              << replay.getTransitionCount() << " presses and releases\n";
+  }
+
+  if (failures)
+    std::cout << failures << " of " << argc - 2 << " replays failed\n";
+
+  return failures ? 1 : 0;
+}